@@ -17,8 +17,8 @@ void AddressableLightDisplay::update() {
   if (!this->enabled_)
     return;
 
-  this->do_update_();
-  this->display();
+  if (this->do_update_())
+    this->display();
 }
 
 void AddressableLightDisplay::display() {
@@ -29,6 +29,9 @@ HomeAssistantServiceCallAction = api_ns.class_(
 )
 APIConnectedCondition = api_ns.class_("APIConnectedCondition", Condition)
 
+CONF_CAMERA_CHUNK_SIZE = "camera_chunk_size"
+CONF_CAMERA_WINDOW = "camera_window"
+
 UserServiceTrigger = api_ns.class_("UserServiceTrigger", automation.Trigger)
 ListEntitiesServicesArgument = api_ns.class_("ListEntitiesServicesArgument")
 SERVICE_ARG_NATIVE_TYPES = {
@@ -50,6 +53,10 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Optional(
             CONF_REBOOT_TIMEOUT, default="15min"
         ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_CAMERA_CHUNK_SIZE, default=1024): cv.int_range(
+            min=256, max=4096
+        ),
+        cv.Optional(CONF_CAMERA_WINDOW, default=4): cv.int_range(min=1, max=16),
         cv.Optional(CONF_SERVICES): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(UserServiceTrigger),
@@ -75,6 +82,8 @@ async def to_code(config):
     cg.add(var.set_port(config[CONF_PORT]))
     cg.add(var.set_password(config[CONF_PASSWORD]))
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    cg.add(var.set_camera_chunk_size(config[CONF_CAMERA_CHUNK_SIZE]))
+    cg.add(var.set_camera_window(config[CONF_CAMERA_WINDOW]))
 
     for conf in config.get(CONF_SERVICES, []):
         template_args = []
@@ -18,6 +18,15 @@ namespace api {
 
 static const char *const TAG = "api.connection";
 
+static const uint32_t FNV1_OFFSET_BASIS = 2166136261UL;
+static const uint32_t FNV1_PRIME = 16777619UL;
+
+static bool is_list_entities_message(uint32_t message_type) {
+  // ListEntities*Response: binary_sensor..text_sensor, services, camera, climate
+  return (message_type >= 12 && message_type <= 18) || message_type == 41 || message_type == 43 ||
+         message_type == 46;
+}
+
 APIConnection::APIConnection(AsyncClient *client, APIServer *parent)
     : client_(client), parent_(parent), initial_state_iterator_(parent, this), list_entities_iterator_(parent, this) {
   this->client_->onError([](void *s, AsyncClient *c, int8_t error) { ((APIConnection *) s)->on_error_(error); }, this);
@@ -27,6 +36,8 @@ APIConnection::APIConnection(AsyncClient *client, APIServer *parent)
   this->client_->onData([](void *s, AsyncClient *c, void *buf,
                            size_t len) { ((APIConnection *) s)->on_data_(reinterpret_cast<uint8_t *>(buf), len); },
                         this);
+  this->client_->onAck([](void *s, AsyncClient *c, size_t len, uint32_t time) { ((APIConnection *) s)->on_ack_(len); },
+                       this);
 
   this->send_buffer_.reserve(64);
   this->recv_buffer_.reserve(32);
@@ -34,13 +45,38 @@ APIConnection::APIConnection(AsyncClient *client, APIServer *parent)
   this->last_traffic_ = millis();
 }
 APIConnection::~APIConnection() { delete this->client_; }
-void APIConnection::on_error_(int8_t error) { this->remove_ = true; }
-void APIConnection::on_disconnect_() { this->remove_ = true; }
-void APIConnection::on_timeout_(uint32_t time) { this->on_fatal_error(); }
+void APIConnection::on_error_(int8_t error) {
+  this->remove_ = true;
+  App.wake_loop();
+}
+void APIConnection::on_ack_(size_t len) {
+  // called from the lwIP thread, only this thread writes tx_acked_
+  this->tx_acked_ += len;
+}
+void APIConnection::on_disconnect_() {
+  this->remove_ = true;
+  App.wake_loop();
+}
+void APIConnection::on_timeout_(uint32_t time) {
+  this->on_fatal_error();
+  App.wake_loop();
+}
 void APIConnection::on_data_(uint8_t *buf, size_t len) {
   if (len == 0 || buf == nullptr)
     return;
   this->recv_buffer_.insert(this->recv_buffer_.end(), buf, buf + len);
+  App.wake_loop();
+}
+bool APIConnection::is_idle_() const {
+  if (this->remove_ || this->next_close_)
+    return false;
+  if (this->list_entities_iterator_.is_active() || this->initial_state_iterator_.is_active())
+    return false;
+#ifdef USE_ESP32_CAMERA
+  if (this->image_reader_.has_image())
+    return false;
+#endif
+  return true;
 }
 void APIConnection::parse_recv_buffer_() {
   if (this->recv_buffer_.empty() || this->remove_)
@@ -84,8 +120,19 @@ void APIConnection::parse_recv_buffer_() {
   }
 }
 
-void APIConnection::disconnect_client() {
+void APIConnection::close_client_() {
+#ifdef USE_ESP32_CAMERA
+  if (this->camera_data_in_flight_()) {
+    // A graceful close keeps retransmitting the image from the camera buffer,
+    // which is handed back to the camera as soon as this connection is deleted.
+    this->client_->abort();
+    return;
+  }
+#endif
   this->client_->close();
+}
+void APIConnection::disconnect_client() {
+  this->close_client_();
   this->remove_ = true;
 }
 
@@ -127,30 +174,108 @@ void APIConnection::loop() {
   }
 
 #ifdef USE_ESP32_CAMERA
-  if (this->image_reader_.available()) {
-    uint32_t space = this->client_->space();
-    // reserve 15 bytes for metadata, and at least 64 bytes of data
-    if (space >= 15 + 64) {
-      uint32_t to_send = std::min(space - 15, this->image_reader_.available());
-      auto buffer = this->create_buffer();
-      // fixed32 key = 1;
-      buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
-      // bytes data = 2;
-      buffer.encode_bytes(2, this->image_reader_.peek_data_buffer(), to_send);
-      // bool done = 3;
-      bool done = this->image_reader_.available() == to_send;
-      buffer.encode_bool(3, done);
-      bool success = this->send_buffer(buffer, 44);
-
-      if (success) {
-        this->image_reader_.consume_data(to_send);
-      }
-      if (success && done) {
-        this->image_reader_.return_image();
-      }
-    }
+  this->camera_loop_();
+#endif
+}
+
+#ifdef USE_ESP32_CAMERA
+void APIConnection::camera_loop_() {
+  if (!this->image_reader_.has_image())
+    return;
+
+  if (this->image_reader_.available() == 0) {
+    // All chunks are queued, but lwIP still references the frame buffer until they are acknowledged
+    if (!this->camera_data_in_flight_())
+      this->image_reader_.return_image();
+    return;
+  }
+
+  const uint32_t chunk_size = this->parent_->get_camera_chunk_size();
+  const uint32_t window = chunk_size * this->parent_->get_camera_window();
+  bool queued = false;
+  while (this->image_reader_.available() != 0) {
+    if (this->tx_queued_ - this->tx_acked_ >= window)
+      break;
+
+    uint32_t to_send = std::min<uint32_t>(chunk_size, this->image_reader_.available());
+    bool done = this->image_reader_.available() == to_send;
+    if (!this->send_camera_chunk_(to_send, done))
+      break;
+
+    this->image_reader_.consume_data(to_send);
+    queued = true;
+    if (done)
+      this->image_end_ = this->tx_queued_;
   }
+  if (queued)
+    this->client_->send();
+}
+bool APIConnection::send_camera_chunk_(uint32_t len, bool done) {
+  // CameraImageResponse - 44
+  // Everything up to the data is copied, the data itself is added without copying from the frame buffer.
+  auto buffer = this->create_buffer();
+  // fixed32 key = 1;
+  buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
+  // bytes data = 2; (tag and length only)
+  buffer.encode_field_raw(2, 2);
+  buffer.encode_varint_raw(len);
+  // bool done = 3;
+  static const uint8_t DONE_FIELD[] = {0x18, 0x01};
+  const uint32_t suffix_size = done ? sizeof(DONE_FIELD) : 0;
+  const uint32_t prefix_size = this->send_buffer_.size();
+
+  std::vector<uint8_t> header;
+  header.push_back(0x00);
+  ProtoVarInt(prefix_size + len + suffix_size).encode(header);
+  ProtoVarInt(44).encode(header);
+  header.insert(header.end(), this->send_buffer_.begin(), this->send_buffer_.end());
+
+  const uint32_t needed_space = header.size() + len + suffix_size;
+  if (this->remove_ || needed_space > this->client_->space())
+    return false;
+
+  this->client_->add(reinterpret_cast<char *>(header.data()), header.size(),
+                     ASYNC_WRITE_FLAG_COPY | ASYNC_WRITE_FLAG_MORE);
+  this->client_->add(reinterpret_cast<char *>(this->image_reader_.peek_data_buffer()), len,
+                     done ? 0 : ASYNC_WRITE_FLAG_MORE);
+  if (done)
+    this->client_->add(reinterpret_cast<const char *>(DONE_FIELD), sizeof(DONE_FIELD), ASYNC_WRITE_FLAG_COPY);
+  this->tx_queued_ += needed_space;
+  return true;
+}
+bool APIConnection::camera_data_in_flight_() const {
+  if (!this->image_reader_.has_image())
+    return false;
+  if (this->image_reader_.available() != 0)
+    // partially sent image, some chunks might not be acknowledged yet
+    return true;
+  return static_cast<int32_t>(this->tx_acked_ - this->image_end_) < 0;
+}
 #endif
+
+void APIConnection::list_entities(const ListEntitiesRequest &msg) {
+  const uint32_t known_hash = this->parent_->get_entities_hash();
+  if (known_hash != 0 && msg.entities_hash == known_hash) {
+    ESP_LOGV(TAG, "'%s' already knows all entities, skipping list", this->client_info_.c_str());
+    this->entities_hash_ = known_hash;
+    this->hashing_entities_ = false;
+    this->list_entities_iterator_.end();
+    return;
+  }
+
+  this->entities_hash_ = FNV1_OFFSET_BASIS;
+  this->hashing_entities_ = true;
+  this->list_entities_iterator_.begin();
+}
+bool APIConnection::send_list_info_done() {
+  if (this->hashing_entities_) {
+    this->hashing_entities_ = false;
+    this->parent_->set_entities_hash(this->entities_hash_);
+  }
+
+  ListEntitiesDoneResponse resp;
+  resp.entities_hash = this->entities_hash_;
+  return this->send_list_entities_done_response(resp);
 }
 
 std::string get_default_unique_id(const std::string &component_type, Nameable *nameable) {
@@ -568,7 +693,8 @@ void APIConnection::climate_command(const ClimateCommandRequest &msg) {
 void APIConnection::send_camera_state(std::shared_ptr<esp32_camera::CameraImage> image) {
   if (!this->state_subscription_)
     return;
-  if (this->image_reader_.available())
+  if (this->image_reader_.has_image())
+    // previous image is still being sent or waiting for acknowledgement
     return;
   this->image_reader_.set_image(image);
 }
@@ -629,7 +755,7 @@ HelloResponse APIConnection::hello(const HelloRequest &msg) {
 
   HelloResponse resp;
   resp.api_version_major = 1;
-  resp.api_version_minor = 4;
+  resp.api_version_minor = 5;
   resp.server_info = App.get_name() + " (esphome v" ESPHOME_VERSION ")";
   this->connection_state_ = ConnectionState::CONNECTED;
   return resp;
@@ -726,7 +852,18 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
                      ASYNC_WRITE_FLAG_COPY | ASYNC_WRITE_FLAG_MORE);
   this->client_->add(reinterpret_cast<char *>(buffer.get_buffer()->data()), buffer.get_buffer()->size(),
                      ASYNC_WRITE_FLAG_COPY);
+  this->tx_queued_ += needed_space;
   bool ret = this->client_->send();
+
+  if (ret && this->hashing_entities_ && is_list_entities_message(message_type)) {
+    // FNV-1 over message type and body, so that reordered or changed entities yield a different hash
+    this->entities_hash_ *= FNV1_PRIME;
+    this->entities_hash_ ^= message_type;
+    for (uint8_t c : *buffer.get_buffer()) {
+      this->entities_hash_ *= FNV1_PRIME;
+      this->entities_hash_ ^= c;
+    }
+  }
   return ret;
 }
 void APIConnection::on_unauthenticated_access() {
@@ -739,7 +876,7 @@ void APIConnection::on_no_setup_connection() {
 }
 void APIConnection::on_fatal_error() {
   ESP_LOGV(TAG, "Error: Disconnecting %s", this->client_info_.c_str());
-  this->client_->close();
+  this->close_client_();
   this->remove_ = true;
 }
 
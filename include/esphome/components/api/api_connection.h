@@ -17,10 +17,7 @@ class APIConnection : public APIServerConnection {
   void disconnect_client();
   void loop();
 
-  bool send_list_info_done() {
-    ListEntitiesDoneResponse resp;
-    return this->send_list_entities_done_response(resp);
-  }
+  bool send_list_info_done();
 #ifdef USE_BINARY_SENSOR
   bool send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state);
   bool send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor);
@@ -98,9 +95,10 @@ class APIConnection : public APIServerConnection {
   }
   PingResponse ping(const PingRequest &msg) override { return {}; }
   DeviceInfoResponse device_info(const DeviceInfoRequest &msg) override;
-  void list_entities(const ListEntitiesRequest &msg) override { this->list_entities_iterator_.begin(); }
+  void list_entities(const ListEntitiesRequest &msg) override;
   void subscribe_states(const SubscribeStatesRequest &msg) override {
     this->state_subscription_ = true;
+    this->initial_state_iterator_.set_bulk(msg.bulk);
     this->initial_state_iterator_.begin();
   }
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
@@ -134,10 +132,19 @@ class APIConnection : public APIServerConnection {
   friend APIServer;
 
   void on_error_(int8_t error);
+  void on_ack_(size_t len);
   void on_disconnect_();
   void on_timeout_(uint32_t time);
   void on_data_(uint8_t *buf, size_t len);
   void parse_recv_buffer_();
+  /// Whether there's nothing to do in loop() until the next callback from the client.
+  bool is_idle_() const;
+  void close_client_();
+#ifdef USE_ESP32_CAMERA
+  void camera_loop_();
+  bool send_camera_chunk_(uint32_t len, bool done);
+  bool camera_data_in_flight_() const;
+#endif
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -153,13 +160,21 @@ class APIConnection : public APIServerConnection {
   std::string client_info_;
 #ifdef USE_ESP32_CAMERA
   esp32_camera::CameraImageReader image_reader_;
+  /// Position in the TCP stream where the zero-copy data of the current image ends.
+  uint32_t image_end_{0};
 #endif
+  /// Bytes handed to the TCP stack / acknowledged by the peer, used to track zero-copy data lifetime.
+  uint32_t tx_queued_{0};
+  volatile uint32_t tx_acked_{0};
 
   bool state_subscription_{false};
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
   uint32_t last_traffic_;
   bool sent_ping_{false};
   bool service_call_subscription_{false};
+  /// FNV-1 hash over the ListEntities*Response messages sent for the current list_entities request.
+  uint32_t entities_hash_{0};
+  bool hashing_entities_{false};
   bool current_nodelay_{false};
   bool next_close_{false};
   AsyncClient *client_;
@@ -423,12 +423,159 @@ void DeviceInfoResponse::dump_to(std::string &out) const {
   out.append("\n");
   out.append("}");
 }
-void ListEntitiesRequest::encode(ProtoWriteBuffer buffer) const {}
-void ListEntitiesRequest::dump_to(std::string &out) const { out.append("ListEntitiesRequest {}"); }
-void ListEntitiesDoneResponse::encode(ProtoWriteBuffer buffer) const {}
-void ListEntitiesDoneResponse::dump_to(std::string &out) const { out.append("ListEntitiesDoneResponse {}"); }
-void SubscribeStatesRequest::encode(ProtoWriteBuffer buffer) const {}
-void SubscribeStatesRequest::dump_to(std::string &out) const { out.append("SubscribeStatesRequest {}"); }
+bool ListEntitiesRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
+  switch (field_id) {
+    case 1: {
+      this->entities_hash = value.as_fixed32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ListEntitiesRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_fixed32(1, this->entities_hash); }
+void ListEntitiesRequest::dump_to(std::string &out) const {
+  char buffer[64];
+  out.append("ListEntitiesRequest {\n");
+  out.append("  entities_hash: ");
+  sprintf(buffer, "%u", this->entities_hash);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+bool ListEntitiesDoneResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
+  switch (field_id) {
+    case 1: {
+      this->entities_hash = value.as_fixed32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ListEntitiesDoneResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_fixed32(1, this->entities_hash); }
+void ListEntitiesDoneResponse::dump_to(std::string &out) const {
+  char buffer[64];
+  out.append("ListEntitiesDoneResponse {\n");
+  out.append("  entities_hash: ");
+  sprintf(buffer, "%u", this->entities_hash);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+bool SubscribeStatesRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->bulk = value.as_bool();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SubscribeStatesRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->bulk); }
+void SubscribeStatesRequest::dump_to(std::string &out) const {
+  char buffer[64];
+  out.append("SubscribeStatesRequest {\n");
+  out.append("  bulk: ");
+  out.append(YESNO(this->bulk));
+  out.append("\n");
+  out.append("}");
+}
+bool AllStatesResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      value.as_packed_32bit(this->binary_sensor_keys);
+      return true;
+    }
+    case 2: {
+      value.as_packed_bool(this->binary_sensor_states);
+      return true;
+    }
+    case 3: {
+      value.as_packed_32bit(this->sensor_keys);
+      return true;
+    }
+    case 4: {
+      value.as_packed_32bit(this->sensor_states);
+      return true;
+    }
+    case 5: {
+      value.as_packed_32bit(this->switch_keys);
+      return true;
+    }
+    case 6: {
+      value.as_packed_bool(this->switch_states);
+      return true;
+    }
+    case 7: {
+      value.as_packed_32bit(this->missing_state_keys);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void AllStatesResponse::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_packed_32bit(1, this->binary_sensor_keys);
+  buffer.encode_packed_bool(2, this->binary_sensor_states);
+  buffer.encode_packed_32bit(3, this->sensor_keys);
+  buffer.encode_packed_32bit(4, this->sensor_states);
+  buffer.encode_packed_32bit(5, this->switch_keys);
+  buffer.encode_packed_bool(6, this->switch_states);
+  buffer.encode_packed_32bit(7, this->missing_state_keys);
+}
+void AllStatesResponse::dump_to(std::string &out) const {
+  char buffer[64];
+  out.append("AllStatesResponse {\n");
+  for (const auto &it : this->binary_sensor_keys) {
+    out.append("  binary_sensor_keys: ");
+    sprintf(buffer, "%u", it);
+    out.append(buffer);
+    out.append("\n");
+  }
+
+  for (const auto it : this->binary_sensor_states) {
+    out.append("  binary_sensor_states: ");
+    out.append(YESNO(it));
+    out.append("\n");
+  }
+
+  for (const auto &it : this->sensor_keys) {
+    out.append("  sensor_keys: ");
+    sprintf(buffer, "%u", it);
+    out.append(buffer);
+    out.append("\n");
+  }
+
+  for (const auto &it : this->sensor_states) {
+    out.append("  sensor_states: ");
+    sprintf(buffer, "%g", it);
+    out.append(buffer);
+    out.append("\n");
+  }
+
+  for (const auto &it : this->switch_keys) {
+    out.append("  switch_keys: ");
+    sprintf(buffer, "%u", it);
+    out.append(buffer);
+    out.append("\n");
+  }
+
+  for (const auto it : this->switch_states) {
+    out.append("  switch_states: ");
+    out.append(YESNO(it));
+    out.append("\n");
+  }
+
+  for (const auto &it : this->missing_state_keys) {
+    out.append("  missing_state_keys: ");
+    sprintf(buffer, "%u", it);
+    out.append(buffer);
+    out.append("\n");
+  }
+  out.append("}");
+}
 bool ListEntitiesBinarySensorResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
   switch (field_id) {
     case 6: {
@@ -195,24 +195,45 @@ class DeviceInfoResponse : public ProtoMessage {
 };
 class ListEntitiesRequest : public ProtoMessage {
  public:
+  uint32_t entities_hash{0};
   void encode(ProtoWriteBuffer buffer) const override;
   void dump_to(std::string &out) const override;
 
  protected:
+  bool decode_32bit(uint32_t field_id, Proto32Bit value) override;
 };
 class ListEntitiesDoneResponse : public ProtoMessage {
  public:
+  uint32_t entities_hash{0};
   void encode(ProtoWriteBuffer buffer) const override;
   void dump_to(std::string &out) const override;
 
  protected:
+  bool decode_32bit(uint32_t field_id, Proto32Bit value) override;
 };
 class SubscribeStatesRequest : public ProtoMessage {
  public:
+  bool bulk{false};
+  void encode(ProtoWriteBuffer buffer) const override;
+  void dump_to(std::string &out) const override;
+
+ protected:
+  bool decode_varint(uint32_t field_id, ProtoVarInt value) override;
+};
+class AllStatesResponse : public ProtoMessage {
+ public:
+  std::vector<uint32_t> binary_sensor_keys{};
+  std::vector<bool> binary_sensor_states{};
+  std::vector<uint32_t> sensor_keys{};
+  std::vector<float> sensor_states{};
+  std::vector<uint32_t> switch_keys{};
+  std::vector<bool> switch_states{};
+  std::vector<uint32_t> missing_state_keys{};
   void encode(ProtoWriteBuffer buffer) const override;
   void dump_to(std::string &out) const override;
 
  protected:
+  bool decode_length(uint32_t field_id, ProtoLengthDelimited value) override;
 };
 class ListEntitiesBinarySensorResponse : public ProtoMessage {
  public:
@@ -40,6 +40,10 @@ bool APIServerConnectionBase::send_list_entities_done_response(const ListEntitie
   ESP_LOGVV(TAG, "send_list_entities_done_response: %s", msg.dump().c_str());
   return this->send_message_<ListEntitiesDoneResponse>(msg, 19);
 }
+bool APIServerConnectionBase::send_all_states_response(const AllStatesResponse &msg) {
+  ESP_LOGVV(TAG, "send_all_states_response: %s", msg.dump().c_str());
+  return this->send_message_<AllStatesResponse>(msg, 49);
+}
 #ifdef USE_BINARY_SENSOR
 bool APIServerConnectionBase::send_list_entities_binary_sensor_response(const ListEntitiesBinarySensorResponse &msg) {
   ESP_LOGVV(TAG, "send_list_entities_binary_sensor_response: %s", msg.dump().c_str());
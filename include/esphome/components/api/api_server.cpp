@@ -33,6 +33,7 @@ void APIServer::setup() {
         // ESP_LOGD(TAG, "New client connected from %s", client->remoteIP().toString().c_str());
         auto *a_this = (APIServer *) s;
         a_this->clients_.push_back(new APIConnection(client, a_this));
+        App.wake_loop();
       },
       this);
 #ifdef USE_LOGGER
@@ -91,6 +92,14 @@ void APIServer::loop() {
     }
   }
 }
+bool APIServer::can_loop_tickless() const {
+  // Client callbacks wake the loop, only unfinished work needs to keep it running
+  for (auto *client : this->clients_) {
+    if (!client->is_idle_())
+      return false;
+  }
+  return true;
+}
 void APIServer::dump_config() {
   ESP_LOGCONFIG(TAG, "API Server:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network_get_address().c_str(), this->port_);
@@ -29,6 +29,7 @@ class APIServer : public Component, public Controller {
   uint16_t get_port() const;
   float get_setup_priority() const override;
   void loop() override;
+  bool can_loop_tickless() const override;
   void dump_config() override;
   void on_shutdown() override;
   bool check_password(const std::string &password) const;
@@ -36,6 +37,10 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  void set_camera_chunk_size(uint32_t camera_chunk_size) { this->camera_chunk_size_ = camera_chunk_size; }
+  uint32_t get_camera_chunk_size() const { return this->camera_chunk_size_; }
+  void set_camera_window(uint32_t camera_window) { this->camera_window_ = camera_window; }
+  uint32_t get_camera_window() const { return this->camera_window_; }
   void handle_disconnect(APIConnection *conn);
 #ifdef USE_BINARY_SENSOR
   void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override;
@@ -68,6 +73,12 @@ class APIServer : public Component, public Controller {
 #endif
 
   bool is_connected() const;
+  /// Number of connected API clients, including the ones that are not authenticated yet.
+  size_t get_client_count() const { return this->clients_.size(); }
+
+  /// Hash of the entity list as computed by the first complete list_entities request, 0 if not known yet.
+  uint32_t get_entities_hash() const { return this->entities_hash_; }
+  void set_entities_hash(uint32_t entities_hash) { this->entities_hash_ = entities_hash; }
 
   struct HomeAssistantStateSubscription {
     std::string entity_id;
@@ -85,6 +96,9 @@ class APIServer : public Component, public Controller {
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
   uint32_t last_connected_{0};
+  uint32_t entities_hash_{0};
+  uint32_t camera_chunk_size_{1024};
+  uint32_t camera_window_{4};
   std::vector<APIConnection *> clients_;
   std::string password_;
   std::vector<HomeAssistantStateSubscription> state_subs_;
@@ -92,6 +92,23 @@ class ProtoLengthDelimited {
     msg.decode(this->value_, this->length_);
     return msg;
   }
+  /// Decode a packed repeated fixed32/float field.
+  template<typename T> void as_packed_32bit(std::vector<T> &out) const {
+    static_assert(sizeof(T) == 4, "Packed 32bit fields must be 4 bytes wide");
+    for (size_t i = 0; i + 4 <= this->length_; i += 4) {
+      union {
+        uint32_t raw;
+        T value;
+      } s{};
+      s.raw = encode_uint32(this->value_[i + 3], this->value_[i + 2], this->value_[i + 1], this->value_[i]);
+      out.push_back(s.value);
+    }
+  }
+  /// Decode a packed repeated bool field.
+  void as_packed_bool(std::vector<bool> &out) const {
+    for (size_t i = 0; i < this->length_; i++)
+      out.push_back(this->value_[i] != 0);
+  }
 
  protected:
   const uint8_t *const value_;
@@ -188,6 +205,36 @@ class ProtoWriteBuffer {
     this->write((value >> 16) & 0xFF);
     this->write((value >> 24) & 0xFF);
   }
+  /// Encode a repeated fixed32/float field in packed form (one tag + length for all values).
+  template<typename T> void encode_packed_32bit(uint32_t field_id, const std::vector<T> &values) {
+    static_assert(sizeof(T) == 4, "Packed 32bit fields must be 4 bytes wide");
+    if (values.empty())
+      return;
+
+    this->encode_field_raw(field_id, 2);
+    this->encode_varint_raw(values.size() * 4);
+    for (const T &it : values) {
+      union {
+        T value;
+        uint32_t raw;
+      } val{};
+      val.value = it;
+      this->write((val.raw >> 0) & 0xFF);
+      this->write((val.raw >> 8) & 0xFF);
+      this->write((val.raw >> 16) & 0xFF);
+      this->write((val.raw >> 24) & 0xFF);
+    }
+  }
+  /// Encode a repeated bool field in packed form.
+  void encode_packed_bool(uint32_t field_id, const std::vector<bool> &values) {
+    if (values.empty())
+      return;
+
+    this->encode_field_raw(field_id, 2);
+    this->encode_varint_raw(values.size());
+    for (bool it : values)
+      this->write(it ? 0x01 : 0x00);
+  }
   template<typename T> void encode_enum(uint32_t field_id, T value, bool force = false) {
     this->encode_uint32(field_id, static_cast<uint32_t>(value), force);
   }
@@ -5,9 +5,19 @@
 namespace esphome {
 namespace api {
 
+// Keeps a single AllStatesResponse at roughly 600 bytes so that it fits into the TCP send buffer
+static const uint32_t MAX_BULK_ENTRIES = 64;
+
 #ifdef USE_BINARY_SENSOR
 bool InitialStateIterator::on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
-  return this->client_->send_binary_sensor_state(binary_sensor, binary_sensor->state);
+  if (!this->bulk_)
+    return this->client_->send_binary_sensor_state(binary_sensor, binary_sensor->state);
+
+  if (!this->flush_bulk_if_full_())
+    return false;
+  this->bulk_binary_sensors_.push_back(binary_sensor);
+  this->bulk_entries_++;
+  return true;
 }
 #endif
 #ifdef USE_COVER
@@ -21,12 +31,26 @@ bool InitialStateIterator::on_light(light::LightState *light) { return this->cli
 #endif
 #ifdef USE_SENSOR
 bool InitialStateIterator::on_sensor(sensor::Sensor *sensor) {
-  return this->client_->send_sensor_state(sensor, sensor->state);
+  if (!this->bulk_)
+    return this->client_->send_sensor_state(sensor, sensor->state);
+
+  if (!this->flush_bulk_if_full_())
+    return false;
+  this->bulk_sensors_.push_back(sensor);
+  this->bulk_entries_++;
+  return true;
 }
 #endif
 #ifdef USE_SWITCH
 bool InitialStateIterator::on_switch(switch_::Switch *a_switch) {
-  return this->client_->send_switch_state(a_switch, a_switch->state);
+  if (!this->bulk_)
+    return this->client_->send_switch_state(a_switch, a_switch->state);
+
+  if (!this->flush_bulk_if_full_())
+    return false;
+  this->bulk_switches_.push_back(a_switch);
+  this->bulk_entries_++;
+  return true;
 }
 #endif
 #ifdef USE_TEXT_SENSOR
@@ -37,6 +61,66 @@ bool InitialStateIterator::on_text_sensor(text_sensor::TextSensor *text_sensor)
 #ifdef USE_CLIMATE
 bool InitialStateIterator::on_climate(climate::Climate *climate) { return this->client_->send_climate_state(climate); }
 #endif
+bool InitialStateIterator::on_begin() {
+  // drop what's left over from a pass that was aborted by a new subscription
+  this->clear_bulk_();
+  return true;
+}
+bool InitialStateIterator::on_end() { return this->flush_bulk_(); }
+bool InitialStateIterator::flush_bulk_if_full_() {
+  if (this->bulk_entries_ < MAX_BULK_ENTRIES)
+    return true;
+  return this->flush_bulk_();
+}
+bool InitialStateIterator::flush_bulk_() {
+  if (this->bulk_entries_ == 0)
+    return true;
+
+  AllStatesResponse resp;
+#ifdef USE_BINARY_SENSOR
+  for (auto *binary_sensor : this->bulk_binary_sensors_) {
+    if (binary_sensor->has_state()) {
+      resp.binary_sensor_keys.push_back(binary_sensor->get_object_id_hash());
+      resp.binary_sensor_states.push_back(binary_sensor->state);
+    } else {
+      resp.missing_state_keys.push_back(binary_sensor->get_object_id_hash());
+    }
+  }
+#endif
+#ifdef USE_SENSOR
+  for (auto *sensor : this->bulk_sensors_) {
+    if (sensor->has_state()) {
+      resp.sensor_keys.push_back(sensor->get_object_id_hash());
+      resp.sensor_states.push_back(sensor->state);
+    } else {
+      resp.missing_state_keys.push_back(sensor->get_object_id_hash());
+    }
+  }
+#endif
+#ifdef USE_SWITCH
+  for (auto *a_switch : this->bulk_switches_) {
+    resp.switch_keys.push_back(a_switch->get_object_id_hash());
+    resp.switch_states.push_back(a_switch->state);
+  }
+#endif
+  if (!this->client_->send_all_states_response(resp))
+    // TCP buffer full, try again in the next loop
+    return false;
+  this->clear_bulk_();
+  return true;
+}
+void InitialStateIterator::clear_bulk_() {
+#ifdef USE_BINARY_SENSOR
+  this->bulk_binary_sensors_.clear();
+#endif
+#ifdef USE_SENSOR
+  this->bulk_sensors_.clear();
+#endif
+#ifdef USE_SWITCH
+  this->bulk_switches_.clear();
+#endif
+  this->bulk_entries_ = 0;
+}
 InitialStateIterator::InitialStateIterator(APIServer *server, APIConnection *client)
     : ComponentIterator(server), client_(client) {}
 
@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
 #include "esphome/core/defines.h"
+#include "api_pb2.h"
 #include "util.h"
 
 namespace esphome {
@@ -13,6 +14,7 @@ class APIConnection;
 class InitialStateIterator : public ComponentIterator {
  public:
   InitialStateIterator(APIServer *server, APIConnection *client);
+  bool on_begin() override;
 #ifdef USE_BINARY_SENSOR
   bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) override;
 #endif
@@ -37,8 +39,29 @@ class InitialStateIterator : public ComponentIterator {
 #ifdef USE_CLIMATE
   bool on_climate(climate::Climate *climate) override;
 #endif
+  bool on_end() override;
+
+  /// Pack the states of binary sensors, sensors and switches into AllStatesResponse messages.
+  void set_bulk(bool bulk) { this->bulk_ = bulk; }
+
  protected:
+  bool flush_bulk_if_full_();
+  bool flush_bulk_();
+  void clear_bulk_();
+
   APIConnection *client_;
+  bool bulk_{false};
+  // The states are read when the message is sent, a newer state may have been sent to the client in the meantime
+#ifdef USE_BINARY_SENSOR
+  std::vector<binary_sensor::BinarySensor *> bulk_binary_sensors_;
+#endif
+#ifdef USE_SENSOR
+  std::vector<sensor::Sensor *> bulk_sensors_;
+#endif
+#ifdef USE_SWITCH
+  std::vector<switch_::Switch *> bulk_switches_;
+#endif
+  uint32_t bulk_entries_{0};
 };
 
 }  // namespace api
@@ -12,6 +12,10 @@ void ComponentIterator::begin() {
   this->state_ = IteratorState::BEGIN;
   this->at_ = 0;
 }
+void ComponentIterator::end() {
+  this->state_ = IteratorState::MAX;
+  this->at_ = 0;
+}
 void ComponentIterator::advance() {
   bool advance_platform = false;
   bool success = true;
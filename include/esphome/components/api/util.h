@@ -18,7 +18,11 @@ class ComponentIterator {
   ComponentIterator(APIServer *server);
 
   void begin();
+  /// Skip all entities and only run on_end(), for example if the client already knows them.
+  void end();
   void advance();
+  /// Whether the iteration was started and hasn't finished yet.
+  bool is_active() const { return this->state_ != IteratorState::NONE; }
   virtual bool on_begin();
 #ifdef USE_BINARY_SENSOR
   virtual bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) = 0;
@@ -35,7 +35,7 @@ class BinarySensor : public Nameable {
    *
    * @param callback The void(bool) callback.
    */
-  void add_on_state_callback(std::function<void(bool)> &&callback);
+  void add_on_state_callback(InlineFunction<void(bool)> &&callback);
 
   /** Publish a new state to the front-end.
    *
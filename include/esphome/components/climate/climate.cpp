@@ -314,7 +314,7 @@ ClimateCall &ClimateCall::set_swing_mode(optional<ClimateSwingMode> swing_mode)
   return *this;
 }
 
-void Climate::add_on_state_callback(std::function<void()> &&callback) {
+void Climate::add_on_state_callback(InlineFunction<void()> &&callback) {
   this->state_callback_.add(std::move(callback));
 }
 
@@ -213,7 +213,7 @@ class Climate : public Nameable {
    *
    * @param callback The callback to call.
    */
-  void add_on_state_callback(std::function<void()> &&callback);
+  void add_on_state_callback(InlineFunction<void()> &&callback);
 
   /** Make a climate device control call, this is used to control the climate device, see the ClimateCall description
    * for more info.
@@ -140,7 +140,7 @@ class Cover : public Nameable {
    */
   void stop();
 
-  void add_on_state_callback(std::function<void()> &&f);
+  void add_on_state_callback(InlineFunction<void()> &&f);
 
   /** Publish the current state of the cover.
    *
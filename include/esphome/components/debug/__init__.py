@@ -1,19 +1,72 @@
 import esphome.config_validation as cv
 import esphome.codegen as cg
-from esphome.const import CONF_ID
+from esphome.const import CONF_ID, CONF_PLATFORM, CONF_UPDATE_INTERVAL
+from esphome.core import CORE, ID, coroutine_with_priority
 
 CODEOWNERS = ["@OttoWinter"]
 DEPENDENCIES = ["logger"]
 
+CONF_DEBUG_ID = "debug_id"
+CONF_PROFILER = "profiler"
+
 debug_ns = cg.esphome_ns.namespace("debug")
 DebugComponent = debug_ns.class_("DebugComponent", cg.Component)
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(DebugComponent),
+        cv.Optional(CONF_PROFILER): cv.Schema(
+            {
+                cv.Optional(CONF_UPDATE_INTERVAL, default="60s"): cv.update_interval,
+            }
+        ),
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
 
+def _declared_ids(config):
+    if isinstance(config, ID):
+        if config.is_declaration:
+            yield config
+    elif isinstance(config, dict):
+        for value in config.values():
+            yield from _declared_ids(value)
+    elif isinstance(config, list):
+        for value in config:
+            yield from _declared_ids(value)
+
+
+def _component_sources():
+    # Name every declared ID after the integration it belongs to, like "dht.sensor"
+    sources = {}
+    for domain, domain_config in CORE.config.items():
+        entries = domain_config if isinstance(domain_config, list) else [domain_config]
+        for entry in entries:
+            source = domain
+            if isinstance(entry, dict) and CONF_PLATFORM in entry:
+                source = f"{entry[CONF_PLATFORM]}.{domain}"
+            for id_ in _declared_ids(entry):
+                sources.setdefault(id_.id, source)
+    return sources
+
+
+@coroutine_with_priority(-1000.0)
+async def set_component_sources():
+    # Runs after all other integrations, so that every component was created
+    sources = _component_sources()
+    for id_, var in CORE.variables.items():
+        if id_.type is None or not id_.type.inherits_from(cg.Component):
+            continue
+        if id_.id in sources:
+            cg.add(var.set_component_source(sources[id_.id]))
+
+
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
+
+    if CONF_PROFILER in config:
+        cg.add_define("USE_COMPONENT_PROFILER")
+        cg.add(
+            var.set_profiler_interval(config[CONF_PROFILER][CONF_UPDATE_INTERVAL])
+        )
+        CORE.add_job(set_component_sources)
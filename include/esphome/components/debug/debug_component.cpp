@@ -3,6 +3,12 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/version.h"
+#include "esphome/core/application.h"
+#include <algorithm>
+
+#if defined(USE_COMPONENT_PROFILER) && defined(USE_API)
+#include "esphome/components/api/custom_api_device.h"
+#endif
 
 #ifdef ARDUINO_ARCH_ESP32
 #include <rom/rtc.h>
@@ -13,6 +19,20 @@ namespace debug {
 
 static const char *const TAG = "debug";
 
+void DebugComponent::setup() {
+#ifdef USE_COMPONENT_PROFILER
+  if (this->profiler_interval_ != 0) {
+    this->set_interval(const_fnv1_hash("profiler"), this->profiler_interval_, [this]() {
+      this->dump_profile();
+      this->publish_profile_();
+    });
+  }
+#ifdef USE_API
+  api::global_api_server->register_user_service(new api::CustomAPIDeviceService<DebugComponent, bool>(
+      "debug_profiler", {"reset"}, this, &DebugComponent::on_profiler_service_));
+#endif
+#endif
+}
 void DebugComponent::dump_config() {
 #ifndef ESPHOME_LOG_HAS_DEBUG
   ESP_LOGE(TAG, "Debug Component requires debug log level!");
@@ -207,5 +227,77 @@ void DebugComponent::loop() {
 }
 float DebugComponent::get_setup_priority() const { return setup_priority::LATE; }
 
+#ifdef USE_COMPONENT_PROFILER
+/// Upper bound of the histogram bucket that contains the given share of all calls.
+static uint32_t histogram_percentile(const ComponentRuntimeStats &stats, float percentile) {
+  const uint32_t target = stats.call_count * percentile;
+  uint32_t count = 0;
+  for (uint8_t i = 0; i < ComponentRuntimeStats::HISTOGRAM_BUCKETS - 1; i++) {
+    count += stats.histogram[i];
+    if (count > target)
+      return 1UL << i;
+  }
+  return stats.max_time_us;
+}
+
+std::vector<Component *> DebugComponent::sorted_components_() {
+  std::vector<Component *> components = App.get_components();
+  std::sort(components.begin(), components.end(), [](Component *a, Component *b) {
+    return a->get_runtime_stats().total_time_us > b->get_runtime_stats().total_time_us;
+  });
+  return components;
+}
+void DebugComponent::dump_profile() {
+  const uint64_t uptime_us = uint64_t(millis() - this->profile_start_) * 1000;
+  ESP_LOGD(TAG, "Component runtime:");
+  ESP_LOGD(TAG, "  %-20s %8s %10s %6s %8s %8s %8s %9s", "Source", "Calls", "Total ms", "Share", "Avg us", "P99 us",
+           "Max us", "Setup ms");
+  for (auto *component : this->sorted_components_()) {
+    auto &stats = component->get_runtime_stats();
+    if (stats.call_count == 0 && stats.setup_time_us == 0)
+      continue;
+    const uint32_t avg_us = stats.call_count == 0 ? 0 : stats.total_time_us / stats.call_count;
+    ESP_LOGD(TAG, "  %-20s %8u %10u %5.1f%% %8u %8u %8u %9u", component->get_component_source(), stats.call_count,
+             uint32_t(stats.total_time_us / 1000), uptime_us == 0 ? 0.0f : stats.total_time_us * 100.0f / uptime_us,
+             avg_us, histogram_percentile(stats, 0.99f), stats.max_time_us, stats.setup_time_us / 1000);
+  }
+}
+void DebugComponent::publish_profile_() {
+#ifdef USE_TEXT_SENSOR
+  if (this->profiler_text_sensor_ == nullptr)
+    return;
+  const uint64_t uptime_us = uint64_t(millis() - this->profile_start_) * 1000;
+  if (uptime_us == 0)
+    return;
+
+  // The five components that took the largest share of the time, in the form "wifi 1.2%, api 0.8%"
+  std::string state;
+  uint8_t count = 0;
+  for (auto *component : this->sorted_components_()) {
+    auto &stats = component->get_runtime_stats();
+    if (count == 5 || stats.total_time_us == 0)
+      break;
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%s%s %.1f%%", count == 0 ? "" : ", ", component->get_component_source(),
+             stats.total_time_us * 100.0f / uptime_us);
+    state += buffer;
+    count++;
+  }
+  this->profiler_text_sensor_->publish_state(state);
+#endif
+}
+#ifdef USE_API
+void DebugComponent::on_profiler_service_(bool reset) {
+  this->dump_profile();
+  if (!reset)
+    return;
+  for (auto *component : App.get_components())
+    component->get_runtime_stats().reset();
+  this->profile_start_ = millis();
+  ESP_LOGD(TAG, "Component runtime statistics reset.");
+}
+#endif
+#endif
+
 }  // namespace debug
 }  // namespace esphome
@@ -1,17 +1,54 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include <vector>
+
+#ifdef USE_TEXT_SENSOR
+#include "esphome/components/text_sensor/text_sensor.h"
+#endif
 
 namespace esphome {
 namespace debug {
 
 class DebugComponent : public Component {
  public:
+  void setup() override;
   void loop() override;
   float get_setup_priority() const override;
   void dump_config() override;
 
+#ifdef USE_COMPONENT_PROFILER
+  void set_profiler_interval(uint32_t profiler_interval) { this->profiler_interval_ = profiler_interval; }
+#ifdef USE_TEXT_SENSOR
+  void set_profiler_text_sensor(text_sensor::TextSensor *profiler_text_sensor) {
+    this->profiler_text_sensor_ = profiler_text_sensor;
+  }
+#endif
+
+  /// Log the runtime statistics of all components, the ones that took the most time first.
+  void dump_profile();
+#endif
+
  protected:
+#ifdef USE_COMPONENT_PROFILER
+  /// Publish the components with the largest share of the uptime to the text sensor.
+  void publish_profile_();
+#ifdef USE_API
+  /// Handler of the debug_profiler API service.
+  void on_profiler_service_(bool reset);
+#endif
+  /// Registered components, ordered by the time they took so far.
+  std::vector<Component *> sorted_components_();
+
+  uint32_t profiler_interval_{60000};
+  /// Time of the last reset of the statistics.
+  uint32_t profile_start_{0};
+#ifdef USE_TEXT_SENSOR
+  text_sensor::TextSensor *profiler_text_sensor_{nullptr};
+#endif
+#endif
+
   uint32_t free_heap_{};
 };
 
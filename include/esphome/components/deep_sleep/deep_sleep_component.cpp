@@ -35,6 +35,7 @@ void DeepSleepComponent::loop() {
   if (this->next_enter_deep_sleep_)
     this->begin_sleep();
 }
+bool DeepSleepComponent::can_loop_tickless() const { return !this->next_enter_deep_sleep_; }
 float DeepSleepComponent::get_loop_priority() const {
   return -100.0f;  // run after everything else is ready
 }
@@ -59,6 +59,7 @@ class DeepSleepComponent : public Component {
   void setup() override;
   void dump_config() override;
   void loop() override;
+  bool can_loop_tickless() const override;
   float get_loop_priority() const override;
   float get_setup_priority() const override;
 
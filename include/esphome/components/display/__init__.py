@@ -34,6 +34,7 @@ DisplayIsDisplayingPageCondition = display_ns.class_(
 DisplayOnPageChangeTrigger = display_ns.class_("DisplayOnPageChangeTrigger")
 
 CONF_ON_PAGE_CHANGE = "on_page_change"
+CONF_RETAINED_MODE = "retained_mode"
 
 DISPLAY_ROTATIONS = {
     0: display_ns.DISPLAY_ROTATION_0_DEGREES,
@@ -59,6 +60,7 @@ BASIC_DISPLAY_SCHEMA = cv.Schema(
 FULL_DISPLAY_SCHEMA = BASIC_DISPLAY_SCHEMA.extend(
     {
         cv.Optional(CONF_ROTATION): validate_rotation,
+        cv.Optional(CONF_RETAINED_MODE, default=False): cv.boolean,
         cv.Optional(CONF_PAGES): cv.All(
             cv.ensure_list(
                 {
@@ -84,6 +86,8 @@ FULL_DISPLAY_SCHEMA = BASIC_DISPLAY_SCHEMA.extend(
 async def setup_display_core_(var, config):
     if CONF_ROTATION in config:
         cg.add(var.set_rotation(DISPLAY_ROTATIONS[config[CONF_ROTATION]]))
+    if config.get(CONF_RETAINED_MODE, False):
+        cg.add(var.set_retained_mode(True))
     if CONF_PAGES in config:
         pages = []
         for conf in config[CONF_PAGES]:
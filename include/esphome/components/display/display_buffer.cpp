@@ -3,6 +3,8 @@
 #include "esphome/core/application.h"
 #include "esphome/core/color.h"
 #include "esphome/core/log.h"
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
 namespace esphome {
@@ -13,6 +15,75 @@ static const char *const TAG = "display";
 const Color COLOR_OFF(0, 0, 0, 0);
 const Color COLOR_ON(255, 255, 255, 255);
 
+/// Cost of sending a rectangle to the display in addition to its pixels (address window commands), in pixels.
+static const int32_t DIRTY_RECT_OVERHEAD = 32;
+
+static DirtyRect bounding_rect(const DirtyRect &a, const DirtyRect &b) {
+  return DirtyRect{std::min(a.x1, b.x1), std::min(a.y1, b.y1), std::max(a.x2, b.x2), std::max(a.y2, b.y2)};
+}
+
+void DirtyRegion::add(int x, int y, int width, int height) {
+  if (width <= 0 || height <= 0)
+    return;
+  DirtyRect rect{int16_t(x), int16_t(y), int16_t(x + width), int16_t(y + height)};
+
+  while (true) {
+    bool merged = false;
+    for (uint8_t i = 0; i < this->count_; i++) {
+      const DirtyRect bounds = bounding_rect(rect, this->rects_[i]);
+      if (bounds.area() <= rect.area() + this->rects_[i].area() + DIRTY_RECT_OVERHEAD) {
+        // also covers overlapping and contained rectangles
+        rect = bounds;
+        this->rects_[i] = this->rects_[--this->count_];
+        merged = true;
+        break;
+      }
+    }
+    if (merged)
+      continue;
+    if (this->count_ < MAX_RECTS)
+      break;
+
+    // No room left, merge with the rectangle that adds the fewest pixels
+    uint8_t best = 0;
+    int32_t best_growth = INT32_MAX;
+    for (uint8_t i = 0; i < this->count_; i++) {
+      const int32_t growth = bounding_rect(rect, this->rects_[i]).area() - this->rects_[i].area();
+      if (growth < best_growth) {
+        best = i;
+        best_growth = growth;
+      }
+    }
+    rect = bounding_rect(rect, this->rects_[best]);
+    this->rects_[best] = this->rects_[--this->count_];
+  }
+  this->rects_[this->count_++] = rect;
+}
+void DirtyRegion::add(const DirtyRegion &other) {
+  for (const auto &rect : other)
+    this->add(rect.x1, rect.y1, rect.width(), rect.height());
+}
+uint32_t DirtyRegion::area() const {
+  uint32_t area = 0;
+  for (const auto &rect : *this)
+    area += rect.area();
+  return area;
+}
+bool DirtyRegion::contains(int x, int y) const {
+  for (const auto &rect : *this) {
+    if (x >= rect.x1 && x < rect.x2 && y >= rect.y1 && y < rect.y2)
+      return true;
+  }
+  return false;
+}
+bool DirtyRegion::intersects(const DirtyRect &other) const {
+  for (const auto &rect : *this) {
+    if (other.x1 < rect.x2 && rect.x1 < other.x2 && other.y1 < rect.y2 && rect.y1 < other.y2)
+      return true;
+  }
+  return false;
+}
+
 void DisplayBuffer::init_internal_(uint32_t buffer_length) {
   this->buffer_ = new uint8_t[buffer_length];
   if (this->buffer_ == nullptr) {
@@ -21,7 +92,20 @@ void DisplayBuffer::init_internal_(uint32_t buffer_length) {
   }
   this->clear();
 }
-void DisplayBuffer::fill(Color color) { this->filled_rectangle(0, 0, this->get_width(), this->get_height(), color); }
+void DisplayBuffer::fill(Color color) {
+  if (this->recording_ && this->record_(DISPLAY_LIST_FILL, 0, 0, 0, 0, color, 0, 0, this->get_width(),
+                                        this->get_height()) != nullptr)
+    return;
+  if (this->clip_ != nullptr) {
+    this->fill_rect_(0, 0, this->get_width(), this->get_height(), color);
+    return;
+  }
+  this->fill_buffer_internal(color);
+  this->add_dirty_(0, 0, this->get_width_internal(), this->get_height_internal());
+}
+void DisplayBuffer::fill_buffer_internal(Color color) {
+  this->fill_absolute_rect_internal(0, 0, this->get_width_internal(), this->get_height_internal(), color);
+}
 void DisplayBuffer::clear() { this->fill(COLOR_OFF); }
 int DisplayBuffer::get_width() {
   switch (this->rotation_) {
@@ -45,8 +129,13 @@ int DisplayBuffer::get_height() {
       return this->get_width_internal();
   }
 }
-void DisplayBuffer::set_rotation(DisplayRotation rotation) { this->rotation_ = rotation; }
+void DisplayBuffer::set_rotation(DisplayRotation rotation) {
+  this->rotation_ = rotation;
+  this->redraw_all_ = true;
+}
 void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
+  if (this->recording_ && this->record_(DISPLAY_LIST_PIXEL, x, y, 0, 0, color, x, y, 1, 1) != nullptr)
+    return;
   switch (this->rotation_) {
     case DISPLAY_ROTATION_0_DEGREES:
       break;
@@ -63,10 +152,146 @@ void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
       y = this->get_height_internal() - y - 1;
       break;
   }
+  if (this->clip_ != nullptr && !this->clip_->contains(x, y))
+    return;
   this->draw_absolute_pixel_internal(x, y, color);
+  if (this->dirty_tracking_)
+    this->add_dirty_(x, y, 1, 1);
   App.feed_wdt();
 }
+void HOT DisplayBuffer::draw_pixels_at(int x, int y, int width, const Color *colors) {
+  if (this->recording_) {
+    DisplayListEntry *entry = this->record_(DISPLAY_LIST_PIXELS, x, y, width, 0, COLOR_OFF, x, y, width, 1);
+    if (entry != nullptr) {
+      entry->data = this->display_list_colors_.size();
+      this->display_list_colors_.insert(this->display_list_colors_.end(), colors, colors + std::max(width, 0));
+      return;
+    }
+  }
+  if (this->clip_ != nullptr) {
+    for (int i = 0; i < width; i++)
+      this->draw_pixel_at(x + i, y, colors[i]);
+    return;
+  }
+  const int width_internal = this->get_width_internal();
+  const int height_internal = this->get_height_internal();
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES: {
+      if (y < 0 || y >= height_internal)
+        return;
+      if (x < 0) {
+        colors -= x;
+        width += x;
+        x = 0;
+      }
+      width = std::min(width, width_internal - x);
+      if (width <= 0)
+        return;
+      this->draw_absolute_row_internal(x, y, width, colors);
+      if (this->dirty_tracking_)
+        this->add_dirty_(x, y, width, 1);
+      break;
+    }
+    case DISPLAY_ROTATION_90_DEGREES:
+      for (int i = 0; i < width; i++)
+        this->draw_absolute_pixel_internal(width_internal - y - 1, x + i, colors[i]);
+      if (this->dirty_tracking_)
+        this->add_dirty_(width_internal - y - 1, x, 1, width);
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      for (int i = 0; i < width; i++)
+        this->draw_absolute_pixel_internal(width_internal - x - i - 1, height_internal - y - 1, colors[i]);
+      if (this->dirty_tracking_)
+        this->add_dirty_(width_internal - x - width, height_internal - y - 1, width, 1);
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      for (int i = 0; i < width; i++)
+        this->draw_absolute_pixel_internal(y, height_internal - x - i - 1, colors[i]);
+      if (this->dirty_tracking_)
+        this->add_dirty_(y, height_internal - x - width, 1, width);
+      break;
+  }
+  App.feed_wdt();
+}
+void HOT DisplayBuffer::fill_rect_(int x, int y, int width, int height, Color color) {
+  const DirtyRect rect = this->absolute_rect_(x, y, width, height);
+  if (rect.width() <= 0 || rect.height() <= 0)
+    return;
+  if (this->clip_ != nullptr) {
+    for (const auto &clip : *this->clip_) {
+      const int x1 = std::max(rect.x1, clip.x1), y1 = std::max(rect.y1, clip.y1);
+      const int x2 = std::min(rect.x2, clip.x2), y2 = std::min(rect.y2, clip.y2);
+      if (x1 < x2 && y1 < y2)
+        this->fill_absolute_rect_internal(x1, y1, x2 - x1, y2 - y1, color);
+    }
+  } else {
+    this->fill_absolute_rect_internal(rect.x1, rect.y1, rect.width(), rect.height(), color);
+    if (this->dirty_tracking_)
+      this->drawn_.add(rect);
+  }
+  App.feed_wdt();
+}
+DirtyRect DisplayBuffer::absolute_rect_(int x, int y, int width, int height) {
+  if (width <= 0 || height <= 0)
+    return DirtyRect{0, 0, 0, 0};
+  const int width_internal = this->get_width_internal();
+  const int height_internal = this->get_height_internal();
+  // Rotating a rectangle by a multiple of 90 degrees gives another rectangle, see draw_pixel_at()
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      std::swap(x, y);
+      std::swap(width, height);
+      x = width_internal - x - width;
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      x = width_internal - x - width;
+      y = height_internal - y - height;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      std::swap(x, y);
+      std::swap(width, height);
+      y = height_internal - y - height;
+      break;
+  }
+
+  const int x2 = std::min(x + width, width_internal);
+  const int y2 = std::min(y + height, height_internal);
+  x = std::max(x, 0);
+  y = std::max(y, 0);
+  if (x >= x2 || y >= y2)
+    return DirtyRect{0, 0, 0, 0};
+  return DirtyRect{int16_t(x), int16_t(y), int16_t(x2), int16_t(y2)};
+}
+void DisplayBuffer::enable_dirty_tracking_() {
+  this->dirty_tracking_ = true;
+  this->dirty_.add(0, 0, this->get_width_internal(), this->get_height_internal());
+}
+void DisplayBuffer::add_dirty_(int x, int y, int width, int height) {
+  if (!this->dirty_tracking_)
+    return;
+  const int x2 = std::min(x + width, this->get_width_internal());
+  const int y2 = std::min(y + height, this->get_height_internal());
+  x = std::max(x, 0);
+  y = std::max(y, 0);
+  if (x < x2 && y < y2)
+    this->drawn_.add(x, y, x2 - x, y2 - y);
+}
+void HOT DisplayBuffer::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  for (int j = y; j < y + height; j++) {
+    for (int i = x; i < x + width; i++)
+      this->draw_absolute_pixel_internal(i, j, color);
+  }
+}
+void HOT DisplayBuffer::draw_absolute_row_internal(int x, int y, int width, const Color *colors) {
+  for (int i = 0; i < width; i++)
+    this->draw_absolute_pixel_internal(x + i, y, colors[i]);
+}
 void HOT DisplayBuffer::line(int x1, int y1, int x2, int y2, Color color) {
+  if (this->recording_ && this->record_(DISPLAY_LIST_LINE, x1, y1, x2, y2, color, std::min(x1, x2), std::min(y1, y2),
+                                        abs(x2 - x1) + 1, abs(y2 - y1) + 1) != nullptr)
+    return;
   const int32_t dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
   const int32_t dy = -abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
   int32_t err = dx + dy;
@@ -87,28 +312,37 @@ void HOT DisplayBuffer::line(int x1, int y1, int x2, int y2, Color color) {
   }
 }
 void HOT DisplayBuffer::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = x; i < x + width; i++)
-    this->draw_pixel_at(i, y, color);
+  if (this->recording_ &&
+      this->record_(DISPLAY_LIST_HORIZONTAL_LINE, x, y, width, 0, color, x, y, width, 1) != nullptr)
+    return;
+  this->fill_rect_(x, y, width, 1, color);
 }
 void HOT DisplayBuffer::vertical_line(int x, int y, int height, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = y; i < y + height; i++)
-    this->draw_pixel_at(x, i, color);
+  if (this->recording_ && this->record_(DISPLAY_LIST_VERTICAL_LINE, x, y, height, 0, color, x, y, 1, height) != nullptr)
+    return;
+  this->fill_rect_(x, y, 1, height, color);
 }
 void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color) {
+  // the outline is also drawn for negative sizes, from [x1+width-1,y1+height-1] to [x1,y1]
+  if (this->recording_ &&
+      this->record_(DISPLAY_LIST_RECTANGLE, x1, y1, width, height, color, std::min(x1, x1 + width - 1),
+                    std::min(y1, y1 + height - 1), abs(width - 1) + 1, abs(height - 1) + 1) != nullptr)
+    return;
   this->horizontal_line(x1, y1, width, color);
   this->horizontal_line(x1, y1 + height - 1, width, color);
   this->vertical_line(x1, y1, height, color);
   this->vertical_line(x1 + width - 1, y1, height, color);
 }
 void DisplayBuffer::filled_rectangle(int x1, int y1, int width, int height, Color color) {
-  // Future: Use vertical_line and horizontal_line methods depending on rotation to reduce memory accesses.
-  for (int i = y1; i < y1 + height; i++) {
-    this->horizontal_line(x1, i, width, color);
-  }
+  if (this->recording_ &&
+      this->record_(DISPLAY_LIST_FILLED_RECTANGLE, x1, y1, width, height, color, x1, y1, width, height) != nullptr)
+    return;
+  this->fill_rect_(x1, y1, width, height, color);
 }
 void HOT DisplayBuffer::circle(int center_x, int center_xy, int radius, Color color) {
+  if (this->recording_ && this->record_(DISPLAY_LIST_CIRCLE, center_x, center_xy, radius, 0, color, center_x - radius,
+                                        center_xy - radius, 2 * radius + 1, 2 * radius + 1) != nullptr)
+    return;
   int dx = -radius;
   int dy = 0;
   int err = 2 - 2 * radius;
@@ -132,16 +366,17 @@ void HOT DisplayBuffer::circle(int center_x, int center_xy, int radius, Color co
   } while (dx <= 0);
 }
 void DisplayBuffer::filled_circle(int center_x, int center_y, int radius, Color color) {
+  if (this->recording_ &&
+      this->record_(DISPLAY_LIST_FILLED_CIRCLE, center_x, center_y, radius, 0, color, center_x - radius,
+                    center_y - radius, 2 * radius + 1, 2 * radius + 1) != nullptr)
+    return;
   int dx = -int32_t(radius);
   int dy = 0;
   int err = 2 - 2 * radius;
   int e2;
 
   do {
-    this->draw_pixel_at(center_x - dx, center_y + dy, color);
-    this->draw_pixel_at(center_x + dx, center_y + dy, color);
-    this->draw_pixel_at(center_x + dx, center_y - dy, color);
-    this->draw_pixel_at(center_x - dx, center_y - dy, color);
+    // the lines include the outline points
     int hline_width = 2 * (-dx) + 1;
     this->horizontal_line(center_x + dx, center_y + dy, hline_width, color);
     this->horizontal_line(center_x + dx, center_y - dy, hline_width, color);
@@ -163,6 +398,22 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
   int width, height;
   this->get_text_bounds(x, y, text, font, align, &x_start, &y_start, &width, &height);
 
+  if (this->recording_) {
+    int x_offset, baseline;
+    font->measure(text, &width, &x_offset, &baseline, &height);
+    // glyphs are drawn from x_offset, but unknown characters at the start are drawn from 0
+    const int x1 = x_start + std::min(x_offset, 0);
+    DisplayListEntry *entry =
+        this->record_(DISPLAY_LIST_PRINT, x, y, 0, 0, color, x1, y_start, x_start + x_offset + width - x1, height);
+    if (entry != nullptr) {
+      entry->align = uint8_t(align);
+      entry->font = font;
+      entry->data = this->display_list_text_.size();
+      this->display_list_text_.append(text, strlen(text) + 1);
+      return;
+    }
+  }
+
   int i = 0;
   int x_at = x_start;
   while (text[i] != '\0') {
@@ -173,9 +424,7 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
       ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", text[i]);
       if (!font->get_glyphs().empty()) {
         uint8_t glyph_width = font->get_glyphs()[0].glyph_data_->width;
-        for (int glyph_x = 0; glyph_x < glyph_width; glyph_x++)
-          for (int glyph_y = 0; glyph_y < height; glyph_y++)
-            this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
+        this->fill_rect_(x_at, y_start, glyph_width, height, color);
         x_at += glyph_width;
       }
 
@@ -183,19 +432,29 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
       continue;
     }
 
-    const Glyph &glyph = font->get_glyphs()[glyph_n];
-    int scan_x1, scan_y1, scan_width, scan_height;
-    glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
+    const GlyphData *glyph_data = font->get_glyphs()[glyph_n].glyph_data_;
 
-    for (int glyph_x = scan_x1; glyph_x < scan_x1 + scan_width; glyph_x++) {
-      for (int glyph_y = scan_y1; glyph_y < scan_y1 + scan_height; glyph_y++) {
-        if (glyph.get_pixel(glyph_x, glyph_y)) {
-          this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
-        }
+    // Draw the runs of each group of identical rows as rectangles
+    const uint8_t *data = glyph_data->data;
+    const int glyph_x = x_at + glyph_data->offset_x;
+    const int glyph_y = y_start + glyph_data->offset_y;
+    for (int row = 0; row < glyph_data->height;) {
+      const uint8_t rows = pgm_read_byte(data);
+      uint8_t runs = pgm_read_byte(data + 1);
+      data += 2;
+      if (rows == 0)
+        break;
+      int run_x = glyph_x;
+      for (; runs > 0; runs--, data += 2) {
+        run_x += pgm_read_byte(data);
+        const uint8_t length = pgm_read_byte(data + 1);
+        this->fill_rect_(run_x, glyph_y + row, length, rows, color);
+        run_x += length;
       }
+      row += rows;
     }
 
-    x_at += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
+    x_at += glyph_data->width + glyph_data->offset_x;
 
     i += match_length;
   }
@@ -208,28 +467,68 @@ void DisplayBuffer::vprintf_(int x, int y, Font *font, Color color, TextAlign al
 }
 
 void DisplayBuffer::image(int x, int y, Image *image, Color color_on, Color color_off) {
+  const int width = image->get_width();
+  if (this->recording_) {
+    DisplayListEntry *entry =
+        this->record_(DISPLAY_LIST_IMAGE, x, y, 0, 0, color_on, x, y, width, image->get_height());
+    if (entry != nullptr) {
+      entry->color_off = color_off;
+      entry->image = image;
+      entry->data = image->get_current_frame();
+      return;
+    }
+  }
+  if (width <= 0)
+    return;
+  // Decode the rows straight from the data instead of pixel by pixel
+  const uint8_t *data = image->get_data_start();
   switch (image->get_type()) {
-    case IMAGE_TYPE_BINARY:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_pixel(img_x, img_y) ? color_on : color_off);
+    case IMAGE_TYPE_BINARY: {
+      // Draw each row as runs of the same color, bytes without a change of color are skipped as a whole
+      const int stride = (width + 7) / 8;
+      for (int img_y = 0; img_y < image->get_height(); img_y++, data += stride) {
+        int run_start = 0;
+        bool run_on = pgm_read_byte(data) & 0x80;
+        for (int byte_x = 0; byte_x < width; byte_x += 8) {
+          const uint8_t bits = pgm_read_byte(data + byte_x / 8);
+          if (bits == (run_on ? 0xFF : 0x00))
+            continue;
+          const int end = std::min(byte_x + 8, width);
+          for (int img_x = byte_x; img_x < end; img_x++) {
+            const bool on = bits & (0x80 >> (img_x - byte_x));
+            if (on == run_on)
+              continue;
+            this->fill_rect_(x + run_start, y + img_y, img_x - run_start, 1, run_on ? color_on : color_off);
+            run_start = img_x;
+            run_on = on;
+          }
         }
+        this->fill_rect_(x + run_start, y + img_y, width - run_start, 1, run_on ? color_on : color_off);
       }
       break;
+    }
     case IMAGE_TYPE_GRAYSCALE:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_grayscale_pixel(img_x, img_y));
-        }
-      }
-      break;
-    case IMAGE_TYPE_RGB24:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_color_pixel(img_x, img_y));
+    case IMAGE_TYPE_RGB24: {
+      // Draw each row in chunks
+      const bool grayscale = image->get_type() == IMAGE_TYPE_GRAYSCALE;
+      Color row[32];
+      for (int img_y = 0; img_y < image->get_height(); img_y++) {
+        for (int img_x = 0; img_x < width; img_x += 32) {
+          const int count = std::min(32, width - img_x);
+          for (int i = 0; i < count; i++) {
+            if (grayscale) {
+              const uint8_t gray = pgm_read_byte(data++);
+              row[i] = Color(gray, gray, gray, gray);
+            } else {
+              row[i] = Color(pgm_read_byte(data), pgm_read_byte(data + 1), pgm_read_byte(data + 2));
+              data += 3;
+            }
+          }
+          this->draw_pixels_at(x + img_x, y + img_y, count, row);
         }
       }
       break;
+    }
   }
 }
 
@@ -327,14 +626,208 @@ void DisplayBuffer::show_page(DisplayPage *page) {
 }
 void DisplayBuffer::show_next_page() { this->page_->show_next(); }
 void DisplayBuffer::show_prev_page() { this->page_->show_prev(); }
-void DisplayBuffer::do_update_() {
-  this->clear();
+bool DisplayBuffer::do_update_() {
+  if (this->retained_mode_)
+    return this->do_retained_update_();
+
+  if (this->dirty_tracking_) {
+    // The frame is drawn from scratch on a cleared buffer, so it can only differ from the display where something
+    // was drawn by the previous frame or by this one
+    this->dirty_.add(this->drawn_);
+    this->drawn_.clear();
+    this->dirty_tracking_ = false;
+    this->clear();
+    this->dirty_tracking_ = true;
+  } else {
+    this->clear();
+  }
+
+  this->write_page_();
+
+  if (this->dirty_tracking_)
+    this->dirty_.add(this->drawn_);
+  return true;
+}
+void DisplayBuffer::write_page_() {
   if (this->page_ != nullptr) {
     this->page_->get_writer()(*this);
   } else if (this->writer_.has_value()) {
     (*this->writer_)(*this);
   }
 }
+bool DisplayBuffer::do_retained_update_() {
+  // The changed regions are added to dirty_ below, not pixel by pixel
+  const bool dirty_tracking = this->dirty_tracking_;
+  this->dirty_tracking_ = false;
+
+  std::swap(this->display_list_, this->previous_display_list_);
+  this->display_list_.clear();
+  this->display_list_text_.clear();
+  this->display_list_colors_.clear();
+  this->recording_ = true;
+  this->write_page_();
+
+  DirtyRegion changed;
+  if (!this->recording_) {
+    // The display list overflowed and the frame was drawn in full, see record_()
+    changed.add(0, 0, this->get_width_internal(), this->get_height_internal());
+  } else {
+    this->recording_ = false;
+    for (auto &entry : this->display_list_)
+      entry.hash = this->hash_entry_(entry);
+
+    if (this->redraw_all_) {
+      changed.add(0, 0, this->get_width_internal(), this->get_height_internal());
+      this->redraw_all_ = false;
+    } else {
+      // Match the calls in order. Pixels outside the bounds of unmatched calls are drawn by the same calls in the same
+      // order as in the previous frame, so only these bounds have to be redrawn.
+      const auto &previous = this->previous_display_list_;
+      size_t next = 0;
+      for (const auto &entry : this->display_list_) {
+        size_t match = next;
+        while (match < previous.size() && previous[match].hash != entry.hash)
+          match++;
+        if (match == previous.size()) {
+          changed.add(entry.bounds);
+          continue;
+        }
+        for (size_t i = next; i < match; i++)
+          changed.add(previous[i].bounds);
+        next = match + 1;
+      }
+      for (size_t i = next; i < previous.size(); i++)
+        changed.add(previous[i].bounds);
+    }
+
+    if (!changed.empty())
+      this->redraw_(changed);
+  }
+
+  this->dirty_tracking_ = dirty_tracking;
+  if (dirty_tracking)
+    this->dirty_.add(changed);
+  return !changed.empty();
+}
+DisplayListEntry *DisplayBuffer::record_(DisplayListOp op, int x, int y, int a, int b, Color color, int bounds_x,
+                                         int bounds_y, int bounds_width, int bounds_height) {
+  if (this->display_list_.size() >= MAX_DISPLAY_LIST) {
+    // Too many calls to keep track of, draw the recorded ones and the rest of the frame directly
+    ESP_LOGV(TAG, "Display list is full, drawing the frame in full");
+    this->recording_ = false;
+    this->redraw_all_ = true;
+    this->clear();
+    for (const auto &entry : this->display_list_)
+      this->replay_(entry);
+    this->display_list_.clear();
+    return nullptr;
+  }
+
+  this->display_list_.emplace_back();
+  DisplayListEntry &entry = this->display_list_.back();
+  entry.op = op;
+  entry.align = 0;
+  entry.x = x;
+  entry.y = y;
+  entry.a = a;
+  entry.b = b;
+  entry.color = color;
+  entry.image = nullptr;
+  entry.data = 0;
+  entry.bounds = this->absolute_rect_(bounds_x, bounds_y, bounds_width, bounds_height);
+  entry.hash = 0;
+  return &entry;
+}
+uint32_t DisplayBuffer::hash_entry_(const DisplayListEntry &entry) const {
+  // FNV-1, like fnv1_hash()
+  uint32_t hash = 2166136261UL;
+  auto add = [&hash](uint32_t value) {
+    for (uint8_t i = 0; i < 4; i++) {
+      hash = (hash * 16777619UL) ^ (value & 0xFF);
+      value >>= 8;
+    }
+  };
+  add(entry.op | entry.align << 8);
+  add(uint16_t(entry.x) | uint32_t(uint16_t(entry.y)) << 16);
+  add(uint16_t(entry.a) | uint32_t(uint16_t(entry.b)) << 16);
+  add(entry.color.raw_32);
+  switch (entry.op) {
+    case DISPLAY_LIST_PIXELS:
+      for (int i = 0; i < entry.a; i++)
+        add(this->display_list_colors_[entry.data + i].raw_32);
+      break;
+    case DISPLAY_LIST_PRINT:
+      add(reinterpret_cast<uintptr_t>(entry.font));
+      for (const char *c = this->display_list_text_.c_str() + entry.data; *c != '\0'; c++)
+        add(uint8_t(*c));
+      break;
+    case DISPLAY_LIST_IMAGE:
+      add(reinterpret_cast<uintptr_t>(entry.image));
+      add(entry.data);
+      add(entry.color_off.raw_32);
+      break;
+    default:
+      break;
+  }
+  return hash;
+}
+void DisplayBuffer::redraw_(const DirtyRegion &region) {
+  for (const auto &rect : region)
+    this->fill_absolute_rect_internal(rect.x1, rect.y1, rect.width(), rect.height(), COLOR_OFF);
+
+  this->clip_ = &region;
+  for (const auto &entry : this->display_list_) {
+    if (region.intersects(entry.bounds))
+      this->replay_(entry);
+  }
+  this->clip_ = nullptr;
+}
+void DisplayBuffer::replay_(const DisplayListEntry &entry) {
+  switch (entry.op) {
+    case DISPLAY_LIST_FILL:
+      this->fill(entry.color);
+      break;
+    case DISPLAY_LIST_PIXEL:
+      this->draw_pixel_at(entry.x, entry.y, entry.color);
+      break;
+    case DISPLAY_LIST_PIXELS:
+      this->draw_pixels_at(entry.x, entry.y, entry.a, this->display_list_colors_.data() + entry.data);
+      break;
+    case DISPLAY_LIST_LINE:
+      this->line(entry.x, entry.y, entry.a, entry.b, entry.color);
+      break;
+    case DISPLAY_LIST_HORIZONTAL_LINE:
+      this->horizontal_line(entry.x, entry.y, entry.a, entry.color);
+      break;
+    case DISPLAY_LIST_VERTICAL_LINE:
+      this->vertical_line(entry.x, entry.y, entry.a, entry.color);
+      break;
+    case DISPLAY_LIST_RECTANGLE:
+      this->rectangle(entry.x, entry.y, entry.a, entry.b, entry.color);
+      break;
+    case DISPLAY_LIST_FILLED_RECTANGLE:
+      this->filled_rectangle(entry.x, entry.y, entry.a, entry.b, entry.color);
+      break;
+    case DISPLAY_LIST_CIRCLE:
+      this->circle(entry.x, entry.y, entry.a, entry.color);
+      break;
+    case DISPLAY_LIST_FILLED_CIRCLE:
+      this->filled_circle(entry.x, entry.y, entry.a, entry.color);
+      break;
+    case DISPLAY_LIST_PRINT:
+      this->print(entry.x, entry.y, entry.font, entry.color, TextAlign(entry.align),
+                  this->display_list_text_.c_str() + entry.data);
+      break;
+    case DISPLAY_LIST_IMAGE: {
+      // draw the recorded frame, not the one the animation advanced to since
+      const int frame = entry.image->get_current_frame();
+      entry.image->set_current_frame(entry.data);
+      this->image(entry.x, entry.y, entry.image, entry.color, entry.color_off);
+      entry.image->set_current_frame(frame);
+      break;
+    }
+  }
+}
 void DisplayOnPageChangeTrigger::process(DisplayPage *from, DisplayPage *to) {
   if ((this->from_ == nullptr || this->from_ == from) && (this->to_ == nullptr || this->to_ == to))
     this->trigger(from, to);
@@ -363,9 +856,30 @@ bool Glyph::get_pixel(int x, int y) const {
   const int y_data = y - this->glyph_data_->offset_y;
   if (x_data < 0 || x_data >= this->glyph_data_->width || y_data < 0 || y_data >= this->glyph_data_->height)
     return false;
-  const uint32_t width_8 = ((this->glyph_data_->width + 7u) / 8u) * 8u;
-  const uint32_t pos = x_data + y_data * width_8;
-  return pgm_read_byte(this->glyph_data_->data + (pos / 8u)) & (0x80 >> (pos % 8u));
+  // Find the group of rows, then the run, see GlyphData
+  const uint8_t *data = this->glyph_data_->data;
+  for (int row = 0;;) {
+    const uint8_t rows = pgm_read_byte(data);
+    const uint8_t runs = pgm_read_byte(data + 1);
+    data += 2;
+    if (rows == 0)
+      return false;
+    if (y_data >= row + rows) {
+      row += rows;
+      data += 2 * runs;
+      continue;
+    }
+    int run_x = 0;
+    for (uint8_t i = 0; i < runs; i++, data += 2) {
+      run_x += pgm_read_byte(data);
+      if (x_data < run_x)
+        return false;
+      run_x += pgm_read_byte(data + 1);
+      if (x_data < run_x)
+        return true;
+    }
+    return false;
+  }
 }
 const char *Glyph::get_char() const { return this->glyph_data_->a_char; }
 bool Glyph::compare_to(const char *str) const {
@@ -401,6 +915,12 @@ void Glyph::scan_area(int *x1, int *y1, int *width, int *height) const {
   *height = this->glyph_data_->height;
 }
 int Font::match_next_glyph(const char *str, int *match_length) {
+  const uint8_t c = *str;
+  if (c < 128 && this->ascii_glyphs_[c] != NO_GLYPH) {
+    *match_length = 1;
+    return this->ascii_glyphs_[c];
+  }
+
   int lo = 0;
   int hi = this->glyphs_.size() - 1;
   while (lo != hi) {
@@ -450,6 +970,18 @@ const std::vector<Glyph> &Font::get_glyphs() const { return this->glyphs_; }
 Font::Font(const GlyphData *data, int data_nr, int baseline, int bottom) : baseline_(baseline), bottom_(bottom) {
   for (int i = 0; i < data_nr; ++i)
     glyphs_.emplace_back(data + i);
+
+  // The glyphs are sorted, so the glyphs starting with the same character follow each other
+  memset(this->ascii_glyphs_, NO_GLYPH, sizeof(this->ascii_glyphs_));
+  for (int i = 0; i < data_nr && i < NO_GLYPH; i++) {
+    const char *a_char = data[i].a_char;
+    const auto c = static_cast<uint8_t>(a_char[0]);
+    if (c == 0 || c >= 128 || a_char[1] != '\0')
+      continue;
+    if (i + 1 < data_nr && data[i + 1].a_char[0] == a_char[0])
+      continue;
+    this->ascii_glyphs_[c] = i;
+  }
 }
 
 bool Image::get_pixel(int x, int y) const {
@@ -486,7 +1018,7 @@ bool Animation::get_pixel(int x, int y) const {
     return false;
   const uint32_t width_8 = ((this->width_ + 7u) / 8u) * 8u;
   const uint32_t frame_index = this->height_ * width_8 * this->current_frame_;
-  if (frame_index >= this->width_ * this->height_ * this->animation_frame_count_)
+  if (frame_index >= this->height_ * width_8 * this->animation_frame_count_)
     return false;
   const uint32_t pos = x + y * width_8 + frame_index;
   return pgm_read_byte(this->data_start_ + (pos / 8u)) & (0x80 >> (pos % 8u));
@@ -519,6 +1051,26 @@ Animation::Animation(const uint8_t *data_start, int width, int height, uint32_t
 }
 int Animation::get_animation_frame_count() const { return this->animation_frame_count_; }
 int Animation::get_current_frame() const { return this->current_frame_; }
+void Animation::set_current_frame(int frame) {
+  if (frame >= 0 && frame < this->animation_frame_count_)
+    this->current_frame_ = frame;
+}
+const uint8_t *Animation::get_data_start() const {
+  size_t frame_size;
+  switch (this->type_) {
+    case IMAGE_TYPE_BINARY:
+      frame_size = ((this->width_ + 7u) / 8u) * this->height_;
+      break;
+    case IMAGE_TYPE_GRAYSCALE:
+      frame_size = this->width_ * this->height_;
+      break;
+    case IMAGE_TYPE_RGB24:
+    default:
+      frame_size = this->width_ * this->height_ * 3;
+      break;
+  }
+  return this->data_start_ + frame_size * this->current_frame_;
+}
 void Animation::next_frame() {
   this->current_frame_++;
   if (this->current_frame_ >= animation_frame_count_) {
@@ -85,6 +85,86 @@ class DisplayOnPageChangeTrigger;
 
 using display_writer_t = std::function<void(DisplayBuffer &)>;
 
+/// A rectangle in absolute display coordinates, x2 and y2 are exclusive.
+struct DirtyRect {
+  int16_t x1;
+  int16_t y1;
+  int16_t x2;
+  int16_t y2;
+
+  int width() const { return this->x2 - this->x1; }
+  int height() const { return this->y2 - this->y1; }
+  int32_t area() const { return int32_t(this->width()) * this->height(); }
+};
+
+/** The parts of a display buffer that changed, as a small set of rectangles.
+ *
+ * Rectangles are merged when sending their bounding box to the display costs about as much as sending them one by
+ * one. At most MAX_RECTS rectangles are kept, beyond that a new rectangle is merged with the one that grows least.
+ */
+class DirtyRegion {
+ public:
+  static const uint8_t MAX_RECTS = 8;
+
+  void add(int x, int y, int width, int height);
+  void add(const DirtyRect &rect) { this->add(rect.x1, rect.y1, rect.width(), rect.height()); }
+  void add(const DirtyRegion &other);
+  void clear() { this->count_ = 0; }
+  bool empty() const { return this->count_ == 0; }
+  /// The number of pixels in all rectangles.
+  uint32_t area() const;
+  bool contains(int x, int y) const;
+  bool intersects(const DirtyRect &rect) const;
+
+  const DirtyRect *begin() const { return this->rects_; }
+  const DirtyRect *end() const { return this->rects_ + this->count_; }
+
+ protected:
+  DirtyRect rects_[MAX_RECTS];
+  uint8_t count_{0};
+};
+
+enum DisplayListOp : uint8_t {
+  DISPLAY_LIST_FILL = 0,
+  DISPLAY_LIST_PIXEL,
+  DISPLAY_LIST_PIXELS,
+  DISPLAY_LIST_LINE,
+  DISPLAY_LIST_HORIZONTAL_LINE,
+  DISPLAY_LIST_VERTICAL_LINE,
+  DISPLAY_LIST_RECTANGLE,
+  DISPLAY_LIST_FILLED_RECTANGLE,
+  DISPLAY_LIST_CIRCLE,
+  DISPLAY_LIST_FILLED_CIRCLE,
+  DISPLAY_LIST_PRINT,
+  DISPLAY_LIST_IMAGE,
+};
+
+/** A drawing call recorded in retained mode, see DisplayBuffer::set_retained_mode().
+ *
+ * x, y, a and b are the coordinates of the call, for example the end points of a line or the position, width and
+ * height of a rectangle. data is the offset of the text of print() or of the colors of draw_pixels_at(), or the frame
+ * of an animation at the time of the call, the lambda may advance it afterwards.
+ */
+struct DisplayListEntry {
+  DisplayListOp op;
+  uint8_t align;
+  int16_t x;
+  int16_t y;
+  int16_t a;
+  int16_t b;
+  Color color;
+  Color color_off;
+  union {
+    Font *font;
+    Image *image;
+  };
+  uint32_t data;
+  /// The pixels the call can touch, in absolute coordinates.
+  DirtyRect bounds;
+  /// Hash of all inputs of the call, equal hashes draw the same pixels.
+  uint32_t hash;
+};
+
 #define LOG_DISPLAY(prefix, type, obj) \
   if ((obj) != nullptr) { \
     ESP_LOGCONFIG(TAG, prefix type); \
@@ -94,7 +174,10 @@ using display_writer_t = std::function<void(DisplayBuffer &)>;
 
 class DisplayBuffer {
  public:
-  /// Fill the entire screen with the given color.
+  /** Fill the entire screen with the given color.
+   *
+   * Drivers should override fill_buffer_internal() instead, an override of this isn't recorded in retained mode.
+   */
   virtual void fill(Color color);
   /// Clear the entire screen by filling it with OFF pixels.
   void clear();
@@ -106,6 +189,12 @@ class DisplayBuffer {
   /// Set a single pixel at the specified coordinates to the given color.
   void draw_pixel_at(int x, int y, Color color = COLOR_ON);
 
+  /** Draw a row of pixels from [x,y] to [x+width,y], with one color per pixel.
+   *
+   * The rotation is resolved once for the whole row, which is much faster than drawing the pixels one by one.
+   */
+  void draw_pixels_at(int x, int y, int width, const Color *colors);
+
   /// Draw a straight line from the point [x1,y1] to [x2,y2] with the given color.
   void line(int x1, int y1, int x2, int y2, Color color = COLOR_ON);
 
@@ -304,18 +393,73 @@ class DisplayBuffer {
   /// Internal method to set the display rotation with.
   void set_rotation(DisplayRotation rotation);
 
+  /** Only redraw the parts of the page that changed since the last update.
+   *
+   * The drawing calls of the page are recorded into a display list instead of being drawn. The list is compared with
+   * the one of the previous update, and only the regions of calls that were added, removed or got different inputs
+   * are cleared and drawn again from the list. If nothing changed the buffer is left as is and do_update_() returns
+   * false, so the driver can skip the transfer to the display.
+   *
+   * Calls that don't go through the DisplayBuffer drawing methods aren't recorded and must not be used in retained
+   * mode. Pages with more than MAX_DISPLAY_LIST calls are drawn in full.
+   */
+  void set_retained_mode(bool retained_mode) { this->retained_mode_ = retained_mode; }
+
+  static const uint16_t MAX_DISPLAY_LIST = 128;
+
  protected:
   void vprintf_(int x, int y, Font *font, Color color, TextAlign align, const char *format, va_list arg);
 
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
 
+  /// Fill the whole buffer with the given color. The default implementation fills the display rectangle.
+  virtual void fill_buffer_internal(Color color);
+
+  /** Fill a rectangle in absolute coordinates, i.e. without rotation.
+   *
+   * The rectangle is already clipped to the display. The default implementation draws pixel by pixel, drivers
+   * override this with a fast path for the layout of their buffer.
+   */
+  virtual void fill_absolute_rect_internal(int x, int y, int width, int height, Color color);
+
+  /// Draw a row of pixels in absolute coordinates, already clipped to the display. Drivers can override this too.
+  virtual void draw_absolute_row_internal(int x, int y, int width, const Color *colors);
+
+  /// Fill a rectangle in rotated coordinates, the rotation and clipping are resolved once for the whole rectangle.
+  void fill_rect_(int x, int y, int width, int height, Color color);
+  /// Convert a rectangle in rotated coordinates to absolute coordinates, clipped to the display.
+  DirtyRect absolute_rect_(int x, int y, int width, int height);
+
+  /** Track the parts of the buffer that changed in dirty_, for drivers that can update parts of the display.
+   *
+   * The whole display is marked dirty initially. The driver writes the rectangles of dirty_ to the display after
+   * do_update_() and clears it.
+   */
+  void enable_dirty_tracking_();
+  /// Mark a rectangle in absolute coordinates as drawn by the current frame, it's clipped to the display.
+  void add_dirty_(int x, int y, int width, int height);
+
   virtual int get_height_internal() = 0;
 
   virtual int get_width_internal() = 0;
 
   void init_internal_(uint32_t buffer_length);
 
-  void do_update_();
+  /// Draw the page into the buffer, returns false if nothing changed in retained mode.
+  bool do_update_();
+  bool do_retained_update_();
+  void write_page_();
+
+  /** Record a drawing call with the given coordinates and bounds (in rotated coordinates) in the display list.
+   *
+   * Returns nullptr if the list is full, the frame is then drawn directly and so is the call.
+   */
+  DisplayListEntry *record_(DisplayListOp op, int x, int y, int a, int b, Color color, int bounds_x, int bounds_y,
+                            int bounds_width, int bounds_height);
+  uint32_t hash_entry_(const DisplayListEntry &entry) const;
+  /// Clear the region and draw the calls of the display list that intersect it.
+  void redraw_(const DirtyRegion &region);
+  void replay_(const DisplayListEntry &entry);
 
   uint8_t *buffer_{nullptr};
   DisplayRotation rotation_{DISPLAY_ROTATION_0_DEGREES};
@@ -323,6 +467,25 @@ class DisplayBuffer {
   DisplayPage *page_{nullptr};
   DisplayPage *previous_page_{nullptr};
   std::vector<DisplayOnPageChangeTrigger *> on_page_change_triggers_;
+  bool dirty_tracking_{false};
+  /// The parts of the buffer that weren't written to the display yet.
+  DirtyRegion dirty_;
+  /// The parts of the buffer drawn by the current frame.
+  DirtyRegion drawn_;
+
+  bool retained_mode_{false};
+  /// Drawing calls are recorded instead of drawn.
+  bool recording_{false};
+  /// The display list of the previous frame doesn't match the buffer, the next frame is drawn in full.
+  bool redraw_all_{true};
+  std::vector<DisplayListEntry> display_list_;
+  std::vector<DisplayListEntry> previous_display_list_;
+  /// The null-terminated texts of print() calls in the display list.
+  std::string display_list_text_;
+  /// The colors of draw_pixels_at() calls in the display list.
+  std::vector<Color> display_list_colors_;
+  /// Drawing is restricted to this region while parts of the display list are redrawn.
+  const DirtyRegion *clip_{nullptr};
 };
 
 class DisplayPage {
@@ -343,6 +506,12 @@ class DisplayPage {
   DisplayPage *next_{nullptr};
 };
 
+/** A glyph of a font, generated by the font component.
+ *
+ * The bitmap in data is run-length encoded. It consists of groups of identical rows, each starting with the number of
+ * rows and the number of runs of set pixels in them. The runs follow as pairs of bytes: the number of pixels skipped
+ * since the end of the previous run and the length of the run.
+ */
 struct GlyphData {
   const char *a_char;
   const uint8_t *data;
@@ -390,7 +559,11 @@ class Font {
   const std::vector<Glyph> &get_glyphs() const;
 
  protected:
+  static const uint8_t NO_GLYPH = 0xFF;
+
   std::vector<Glyph> glyphs_;
+  /// The glyph of each ASCII character that's only matched by a single glyph, for a lookup without a search.
+  uint8_t ascii_glyphs_[128];
   int baseline_;
   int bottom_;
 };
@@ -404,6 +577,12 @@ class Image {
   int get_width() const;
   int get_height() const;
   ImageType get_type() const;
+  /// The frame that's drawn, for animations.
+  virtual int get_current_frame() const { return 0; }
+  /// Select the frame that's drawn, for animations.
+  virtual void set_current_frame(int frame) {}
+  /// The data of the frame that's drawn, in the layout of the image type.
+  virtual const uint8_t *get_data_start() const { return this->data_start_; }
 
  protected:
   int width_;
@@ -420,7 +599,9 @@ class Animation : public Image {
   Color get_grayscale_pixel(int x, int y) const override;
 
   int get_animation_frame_count() const;
-  int get_current_frame() const;
+  int get_current_frame() const override;
+  void set_current_frame(int frame) override;
+  const uint8_t *get_data_start() const override;
   void next_frame();
 
  protected:
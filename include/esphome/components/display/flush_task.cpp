@@ -0,0 +1,65 @@
+#include "flush_task.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include <Arduino.h>
+
+namespace esphome {
+namespace display {
+
+bool FlushTask::start(const char *name, std::function<void()> &&flush) {
+  this->flush_ = std::move(flush);
+  this->start_ = xSemaphoreCreateBinary();
+  this->idle_ = xSemaphoreCreateBinary();
+  if (this->start_ == nullptr || this->idle_ == nullptr)
+    return false;
+  xSemaphoreGive(this->idle_);
+  // The loop runs on core 1, send on core 0 at the priority of the loop so that WiFi and the network stack come first
+  return xTaskCreatePinnedToCore(&FlushTask::task_, name, 4096, this, 1, nullptr, 0) == pdPASS;
+}
+void FlushTask::wait() {
+  const uint32_t start = micros();
+  xSemaphoreTake(this->idle_, portMAX_DELAY);
+  xSemaphoreGive(this->idle_);
+  this->wait_time_ = micros() - start;
+  if (this->flushing_) {
+    this->flushing_ = false;
+    this->flush_count_++;
+    this->total_flush_time_ += this->flush_time_;
+    this->total_overlap_time_ += this->get_overlap_time();
+  }
+}
+void FlushTask::flush() {
+  xSemaphoreTake(this->idle_, portMAX_DELAY);
+  this->flushing_ = true;
+  xSemaphoreGive(this->start_);
+}
+void FlushTask::report_stats(const char *tag) {
+  const uint32_t now = millis();
+  if (now - this->last_report_ < 60000 || this->flush_count_ == 0)
+    return;
+  ESP_LOGD(tag, "%u flushes, on average %u us long and %u us of it in parallel to the loop",  // NOLINT
+           this->flush_count_, uint32_t(this->total_flush_time_ / this->flush_count_),
+           uint32_t(this->total_overlap_time_ / this->flush_count_));
+  this->flush_count_ = 0;
+  this->total_flush_time_ = 0;
+  this->total_overlap_time_ = 0;
+  this->last_report_ = now;
+}
+void FlushTask::task_(void *arg) {
+  auto *flush_task = reinterpret_cast<FlushTask *>(arg);
+  while (true) {
+    xSemaphoreTake(flush_task->start_, portMAX_DELAY);
+    const uint32_t start = micros();
+    flush_task->flush_();
+    flush_task->flush_time_ = micros() - start;
+    xSemaphoreGive(flush_task->idle_);
+  }
+}
+
+}  // namespace display
+}  // namespace esphome
+
+#endif
@@ -0,0 +1,61 @@
+#pragma once
+
+#ifdef ARDUINO_ARCH_ESP32
+
+#include <cstdint>
+#include <functional>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+namespace esphome {
+namespace display {
+
+/** Sends frames to a display in a background task, so that the loop can continue while the transfer is running.
+ *
+ * The driver copies the changed parts of its buffer into a second buffer that's only read by the task and calls
+ * flush(). Before overwriting that copy with the next frame it calls wait(), which only blocks if the previous flush
+ * is still running.
+ */
+class FlushTask {
+ public:
+  /// Start the task, `flush` is called in it for every frame. Returns false if the task couldn't be created.
+  bool start(const char *name, std::function<void()> &&flush);
+  /// Block until the previous flush finished.
+  void wait();
+  /// Start sending the copied frame.
+  void flush();
+
+  /// The duration of the last flush in microseconds.
+  uint32_t get_flush_time() const { return this->flush_time_; }
+  /// How long the loop was blocked by wait() before the last flush, in microseconds.
+  uint32_t get_wait_time() const { return this->wait_time_; }
+  /// How long the previous flush ran in parallel to the loop, in microseconds.
+  uint32_t get_overlap_time() const {
+    return this->flush_time_ > this->wait_time_ ? this->flush_time_ - this->wait_time_ : 0;
+  }
+  /// Log the average flush and overlap time at debug level, at most once a minute.
+  void report_stats(const char *tag);
+
+ protected:
+  static void task_(void *arg);
+
+  std::function<void()> flush_;
+  /// Given by flush(), taken by the task.
+  SemaphoreHandle_t start_{nullptr};
+  /// Held while a flush is running.
+  SemaphoreHandle_t idle_{nullptr};
+  volatile uint32_t flush_time_{0};
+  uint32_t wait_time_{0};
+  bool flushing_{false};
+  /// Totals since the last report.
+  uint32_t flush_count_{0};
+  uint64_t total_flush_time_{0};
+  uint64_t total_overlap_time_{0};
+  uint32_t last_report_{0};
+};
+
+}  // namespace display
+}  // namespace esphome
+
+#endif
@@ -16,6 +16,8 @@ namespace e131 {
 
 static const char *const TAG = "e131";
 static const int PORT = 5568;
+// Packets stop waiting for sync packets if none were received for this long, see E1.31 section 6.2.4.1
+static const uint32_t SYNC_TIMEOUT = 2500;
 
 E131Component::E131Component() {}
 
@@ -23,6 +25,10 @@ E131Component::~E131Component() {
   if (udp_) {
     udp_->stop();
   }
+  for (auto &universe : this->universes_)
+    delete universe.second.pending_slot;
+  for (auto *slot : this->free_slots_)
+    delete slot;
 }
 
 void E131Component::setup() {
@@ -38,28 +44,103 @@ void E131Component::setup() {
 }
 
 void E131Component::loop() {
-  std::vector<uint8_t> payload;
   E131Packet packet;
   int universe = 0;
+  uint16_t sync_address = 0;
 
   while (uint16_t packet_size = udp_->parsePacket()) {
-    payload.resize(packet_size);
+    // read the datagram straight into a receive slot, the packet is parsed and applied from there
+    auto *slot = this->acquire_slot_();
+    const size_t size = std::min<size_t>(packet_size, sizeof(slot->data));
 
-    if (!udp_->read(&payload[0], payload.size())) {
+    if (!udp_->read(slot->data, size)) {
+      this->release_slot_(slot);
       continue;
     }
 
-    if (!packet_(payload, universe, packet)) {
-      ESP_LOGV(TAG, "Invalid packet recevied of size %zu.", payload.size());
+    if (sync_packet_(slot->data, size, sync_address)) {
+      this->release_slot_(slot);
+      this->sync_(sync_address);
+      continue;
+    }
+
+    if (!packet_(slot->data, size, universe, packet)) {
+      ESP_LOGV(TAG, "Invalid packet recevied of size %u.", packet_size);
+      this->release_slot_(slot);
+      continue;
+    }
+
+    auto consumers = this->universe_consumers_.find(universe);
+    if (consumers == this->universe_consumers_.end() || consumers->second == 0) {
+      ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, packet.count);
+      this->release_slot_(slot);
+      continue;
+    }
+
+    if (!this->check_sequence_(universe, packet.sequence_number)) {
+      ESP_LOGV(TAG, "Dropped out-of-order packet %u for %d universe.", packet.sequence_number, universe);
+      this->release_slot_(slot);
+      continue;
+    }
+
+    auto &state = this->universes_[universe];
+    // a newer packet replaces the one that's still waiting
+    if (state.pending_slot != nullptr) {
+      this->release_slot_(state.pending_slot);
+      state.pending_slot = nullptr;
+    }
+
+    if (packet.sync_address != 0 && this->last_sync_.has_value() && millis() - *this->last_sync_ < SYNC_TIMEOUT) {
+      // wait for the sync packet, so that all universes of the frame are applied at once
+      state.pending_slot = slot;
+      state.pending_packet = packet;
       continue;
     }
 
     if (!process_(universe, packet)) {
       ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, packet.count);
     }
+    this->release_slot_(slot);
+  }
+}
+
+bool E131Component::check_sequence_(int universe, uint8_t sequence_number) {
+  auto &last = this->universes_[universe].sequence_number;
+  // packets up to 20 behind the last one are stale or out of order, see E1.31 section 6.7.2
+  if (last.has_value()) {
+    auto diff = static_cast<int8_t>(sequence_number - *last);
+    if (diff <= 0 && diff > -20)
+      return false;
+  }
+  last = sequence_number;
+  return true;
+}
+
+void E131Component::sync_(uint16_t sync_address) {
+  this->last_sync_ = millis();
+
+  for (auto &universe : this->universes_) {
+    auto &state = universe.second;
+    if (state.pending_slot == nullptr || state.pending_packet.sync_address != sync_address)
+      continue;
+
+    process_(universe.first, state.pending_packet);
+    this->release_slot_(state.pending_slot);
+    state.pending_slot = nullptr;
   }
 }
 
+E131ReceiveSlot *E131Component::acquire_slot_() {
+  if (this->free_slots_.empty())
+    return new E131ReceiveSlot();
+
+  auto *slot = this->free_slots_.back();
+  this->free_slots_.pop_back();
+  return slot;
+}
+
+void E131Component::release_slot_(E131ReceiveSlot *slot) { this->free_slots_.push_back(slot); }
+
 void E131Component::add_effect(E131AddressableLightEffect *light_effect) {
   if (light_effects_.count(light_effect)) {
     return;
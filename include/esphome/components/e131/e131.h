@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 
 #include <memory>
 #include <set>
@@ -16,10 +17,29 @@ class E131AddressableLightEffect;
 enum E131ListenMethod { E131_MULTICAST, E131_UNICAST };
 
 const int E131_MAX_PROPERTY_VALUES_COUNT = 513;
+const int E131_MAX_PACKET_SIZE = 638;
 
+/// A data packet, parsed in place: the values point into the receive slot it was read into.
 struct E131Packet {
   uint16_t count;
-  uint8_t values[E131_MAX_PROPERTY_VALUES_COUNT];
+  /// The start code followed by the channel values.
+  const uint8_t *values;
+  uint8_t sequence_number;
+  /// The universe whose sync packet applies this packet, 0 if it's applied right away.
+  uint16_t sync_address;
+};
+
+/// Buffer for one datagram. A packet waiting for its sync packet keeps its slot until it's applied.
+struct E131ReceiveSlot {
+  uint8_t data[E131_MAX_PACKET_SIZE];
+};
+
+struct E131UniverseState {
+  /// The sequence number of the last accepted packet, to drop stale and out-of-order packets.
+  optional<uint8_t> sequence_number;
+  /// The last packet that waits for a sync packet, and its slot.
+  E131ReceiveSlot *pending_slot{nullptr};
+  E131Packet pending_packet;
 };
 
 class E131Component : public esphome::Component {
@@ -39,8 +59,15 @@ class E131Component : public esphome::Component {
   void set_method(E131ListenMethod listen_method) { this->listen_method_ = listen_method; }
 
  protected:
-  bool packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet);
+  bool packet_(const uint8_t *data, size_t size, int &universe, E131Packet &packet);
+  bool sync_packet_(const uint8_t *data, size_t size, uint16_t &sync_address);
+  /// Whether the sequence number is newer than the one of the last packet of the universe.
+  bool check_sequence_(int universe, uint8_t sequence_number);
+  /// Apply all packets waiting for the sync packet of the given address at once.
+  void sync_(uint16_t sync_address);
   bool process_(int universe, const E131Packet &packet);
+  E131ReceiveSlot *acquire_slot_();
+  void release_slot_(E131ReceiveSlot *slot);
   bool join_igmp_groups_();
   void join_(int universe);
   void leave_(int universe);
@@ -50,7 +77,11 @@ class E131Component : public esphome::Component {
   std::unique_ptr<UDP> udp_;
   std::set<E131AddressableLightEffect *> light_effects_;
   std::map<int, int> universe_consumers_;
-  std::map<int, E131Packet> universe_packets_;
+  std::map<int, E131UniverseState> universes_;
+  /// Receive slots that aren't in use, packets are read into them without another copy.
+  std::vector<E131ReceiveSlot *> free_slots_;
+  /// When the last sync packet was received. Packets only wait for sync packets while they keep coming.
+  optional<uint32_t> last_sync_{};
 };
 
 }  // namespace e131
@@ -6,7 +6,7 @@ namespace esphome {
 namespace e131 {
 
 static const char *const TAG = "e131_addressable_light_effect";
-static const int MAX_DATA_SIZE = (sizeof(E131Packet::values) - 1);
+static const int MAX_DATA_SIZE = (E131_MAX_PROPERTY_VALUES_COUNT - 1);
 
 E131AddressableLightEffect::E131AddressableLightEffect(const std::string &name) : AddressableLightEffect(name) {}
 
@@ -60,28 +60,34 @@ bool E131AddressableLightEffect::process_(int universe, const E131Packet &packet
   ESP_LOGV(TAG, "Applying data for '%s' on %d universe, for %d-%d.", get_name().c_str(), universe, output_offset,
            output_end);
 
-  switch (channels_) {
-    case E131_MONO:
-      for (; output_offset < output_end; output_offset++, input_data++) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[0], input_data[0], input_data[0]));
-      }
-      break;
-
-    case E131_RGB:
-      for (; output_offset < output_end; output_offset++, input_data += 3) {
-        auto output = (*it)[output_offset];
-        output.set(
-            Color(input_data[0], input_data[1], input_data[2], (input_data[0] + input_data[1] + input_data[2]) / 3));
-      }
-      break;
-
-    case E131_RGBW:
-      for (; output_offset < output_end; output_offset++, input_data += 4) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[1], input_data[2], input_data[3]));
-      }
-      break;
+  // convert the values in chunks and write them straight into the buffer of the light
+  Color colors[light::ADDRESSABLE_EFFECT_CHUNK_SIZE];
+  while (output_offset < output_end) {
+    const int count = std::min<int>(output_end - output_offset, light::ADDRESSABLE_EFFECT_CHUNK_SIZE);
+
+    switch (channels_) {
+      case E131_MONO:
+        for (int i = 0; i < count; i++, input_data++) {
+          colors[i] = Color(input_data[0], input_data[0], input_data[0], input_data[0]);
+        }
+        break;
+
+      case E131_RGB:
+        for (int i = 0; i < count; i++, input_data += 3) {
+          colors[i] =
+              Color(input_data[0], input_data[1], input_data[2], (input_data[0] + input_data[1] + input_data[2]) / 3);
+        }
+        break;
+
+      case E131_RGBW:
+        for (int i = 0; i < count; i++, input_data += 4) {
+          colors[i] = Color(input_data[0], input_data[1], input_data[2], input_data[3]);
+        }
+        break;
+    }
+
+    it->write_colors(output_offset, colors, count);
+    output_offset += count;
   }
 
   return true;
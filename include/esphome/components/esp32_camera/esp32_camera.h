@@ -25,6 +25,8 @@ class CameraImage {
 class CameraImageReader {
  public:
   void set_image(std::shared_ptr<CameraImage> image);
+  /// Whether an image is held, even if all of its data was already consumed.
+  bool has_image() const { return this->image_ != nullptr; }
   size_t available() const;
   uint8_t *peek_data_buffer();
   void consume_data(size_t consumed);
@@ -72,7 +74,7 @@ class ESP32Camera : public Component, public Nameable {
   void setup() override;
   void loop() override;
   void dump_config() override;
-  void add_image_callback(std::function<void(std::shared_ptr<CameraImage>)> &&f);
+  void add_image_callback(InlineFunction<void(std::shared_ptr<CameraImage>)> &&f);
   float get_setup_priority() const override;
   void request_stream();
   void request_image();
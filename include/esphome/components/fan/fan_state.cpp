@@ -9,7 +9,7 @@ static const char *const TAG = "fan";
 
 const FanTraits &FanState::get_traits() const { return this->traits_; }
 void FanState::set_traits(const FanTraits &traits) { this->traits_ = traits; }
-void FanState::add_on_state_callback(std::function<void()> &&callback) {
+void FanState::add_on_state_callback(InlineFunction<void()> &&callback) {
   this->state_callback_.add(std::move(callback));
 }
 FanState::FanState(const std::string &name) : Nameable(name) {}
@@ -72,7 +72,7 @@ class FanState : public Nameable, public Component {
   explicit FanState(const std::string &name);
 
   /// Register a callback that will be called each time the state changes.
-  void add_on_state_callback(std::function<void()> &&callback);
+  void add_on_state_callback(InlineFunction<void()> &&callback);
 
   /// Get the traits of this fan (i.e. what features it supports).
   const FanTraits &get_traits() const;
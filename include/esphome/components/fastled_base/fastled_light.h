@@ -227,6 +227,11 @@ class FastLEDLightOutput : public light::AddressableLight {
     return {&this->leds_[index].r,      &this->leds_[index].g, &this->leds_[index].b, nullptr,
             &this->effect_data_[index], &this->correction_};
   }
+  bool get_raw_pixels_internal(light::ESPRawPixels *raw) const override {
+    // CRGB is always stored as r, g, b, the controller reorders the bytes while sending them
+    *raw = {&this->leds_[0].r, sizeof(CRGB), {0, 1, 2, 3}, this->effect_data_};
+    return true;
+  }
 
   CLEDController *controller_{nullptr};
   CRGB *leds_{nullptr};
@@ -92,6 +92,47 @@ FONT_SCHEMA = cv.Schema(
 CONFIG_SCHEMA = cv.All(validate_pillow_installed, FONT_SCHEMA)
 
 
+def encode_glyph(mask, width, height):
+    """Run-length encode the set pixels of a glyph, see GlyphData in display_buffer.h."""
+    rows = []
+    for y in range(height):
+        runs = []
+        end = 0
+        x = 0
+        while x < width:
+            if not mask.getpixel((x, y)):
+                x += 1
+                continue
+            start = x
+            while x < width and mask.getpixel((x, y)):
+                x += 1
+            skip, length = start - end, x - start
+            # skips and lengths are stored in a byte, split longer ones into several runs
+            while skip > 255:
+                runs.append((255, 0))
+                skip -= 255
+            while length > 255:
+                runs.append((skip, 255))
+                skip, length = 0, length - 255
+            runs.append((skip, length))
+            end = x
+        if len(runs) > 255:
+            raise core.EsphomeError("The font is too big, please use a smaller size")
+        rows.append(runs)
+
+    data = []
+    y = 0
+    while y < height:
+        count = 1
+        while y + count < height and count < 255 and rows[y + count] == rows[y]:
+            count += 1
+        data += [count, len(rows[y])]
+        for run in rows[y]:
+            data += run
+        y += count
+    return data
+
+
 async def to_code(config):
     from PIL import ImageFont
 
@@ -109,14 +150,7 @@ async def to_code(config):
         mask = font.getmask(glyph, mode="1")
         _, (offset_x, offset_y) = font.font.getsize(glyph)
         width, height = mask.size
-        width8 = ((width + 7) // 8) * 8
-        glyph_data = [0 for _ in range(height * width8 // 8)]  # noqa: F812
-        for y in range(height):
-            for x in range(width):
-                if not mask.getpixel((x, y)):
-                    continue
-                pos = x + y * width8
-                glyph_data[pos // 8] |= 0x80 >> (pos % 8)
+        glyph_data = encode_glyph(mask, width, height)
         glyph_args[glyph] = (len(data), offset_x, offset_y, width, height)
         data += glyph_data
 
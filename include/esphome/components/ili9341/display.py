@@ -14,6 +14,7 @@ from esphome.const import (
 DEPENDENCIES = ["spi"]
 
 CONF_LED_PIN = "led_pin"
+CONF_ASYNC_FLUSH = "async_flush"
 
 ili9341_ns = cg.esphome_ns.namespace("ili9341")
 ili9341 = ili9341_ns.class_(
@@ -39,6 +40,9 @@ CONFIG_SCHEMA = cv.All(
             cv.Required(CONF_DC_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_RESET_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_LED_PIN): pins.gpio_output_pin_schema,
+            cv.Optional(CONF_ASYNC_FLUSH, default=False): cv.All(
+                cv.boolean, cv.only_on_esp32
+            ),
         }
     )
     .extend(cv.polling_component_schema("1s"))
@@ -73,3 +77,5 @@ async def to_code(config):
     if CONF_LED_PIN in config:
         led_pin = await cg.gpio_pin_expression(config[CONF_LED_PIN])
         cg.add(var.set_led_pin(led_pin))
+    if config[CONF_ASYNC_FLUSH]:
+        cg.add(var.set_async_flush(True))
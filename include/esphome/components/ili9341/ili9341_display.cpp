@@ -2,6 +2,7 @@
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
+#include <new>
 
 namespace esphome {
 namespace ili9341 {
@@ -32,6 +33,9 @@ void ILI9341Display::dump_config() {
   LOG_PIN("  DC Pin: ", this->dc_pin_);
   LOG_PIN("  Busy Pin: ", this->busy_pin_);
   LOG_PIN("  Backlight Pin: ", this->led_pin_);
+#ifdef ARDUINO_ARCH_ESP32
+  ESP_LOGCONFIG(TAG, "  Async Flush: %s", YESNO(this->flush_task_ != nullptr));
+#endif
   LOG_UPDATE_INTERVAL(this);
 }
 
@@ -78,35 +82,76 @@ uint8_t ILI9341Display::read_command(uint8_t command_byte, uint8_t index) {
   return result;
 }
 
-void ILI9341Display::update() {
-  this->do_update_();
-  this->display_();
+void ILI9341Display::setup_flush_task_() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (!this->async_flush_)
+    return;
+  if (!this->parent_->is_hardware()) {
+    ESP_LOGW(TAG, "Async flush needs a hardware SPI bus, sending frames synchronously");
+    return;
+  }
+  this->flush_buffer_ = new (std::nothrow) uint8_t[this->get_buffer_length_()];
+  if (this->flush_buffer_ == nullptr) {
+    ESP_LOGW(TAG, "Could not allocate the flush buffer, sending frames synchronously");
+    return;
+  }
+  auto *flush_task = new display::FlushTask();
+  if (!flush_task->start("ili9341_flush", [this]() { this->display_(this->flush_buffer_, this->flush_region_); })) {
+    ESP_LOGW(TAG, "Could not start the flush task, sending frames synchronously");
+    delete flush_task;
+    delete[] this->flush_buffer_;
+    this->flush_buffer_ = nullptr;
+    return;
+  }
+  this->flush_task_ = flush_task;
+#endif
 }
 
-void ILI9341Display::display_() {
-  // we will only update the changed window to the display
-  int w = this->x_high_ - this->x_low_ + 1;
-  int h = this->y_high_ - this->y_low_ + 1;
+void ILI9341Display::update() {
+  this->do_update_();
+  if (this->dirty_.empty())
+    return;
 
-  set_addr_window_(this->x_low_, this->y_low_, w, h);
-  this->start_data_();
-  uint32_t start_pos = ((this->y_low_ * this->width_) + x_low_);
-  for (uint16_t row = 0; row < h; row++) {
-    for (uint16_t col = 0; col < w; col++) {
-      uint32_t pos = start_pos + (row * width_) + col;
-
-      uint16_t color = convert_to_16bit_color_(buffer_[pos]);
-      this->write_byte(color >> 8);
-      this->write_byte(color);
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->flush_task_ != nullptr) {
+    // The previous frame must have been sent before its copy is overwritten
+    this->flush_task_->wait();
+    for (const auto &rect : this->dirty_) {
+      for (int row = rect.y1; row < rect.y2; row++) {
+        const uint32_t pos = row * this->width_ + rect.x1;
+        memcpy(this->flush_buffer_ + pos, this->buffer_ + pos, rect.width());
+      }
     }
+    this->flush_region_ = this->dirty_;
+    this->dirty_.clear();
+    this->flush_task_->flush();
+    this->flush_task_->report_stats(TAG);
+    return;
   }
-  this->end_data_();
+#endif
 
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
+  this->display_(this->buffer_, this->dirty_);
+  this->dirty_.clear();
+}
+
+void ILI9341Display::display_(const uint8_t *buffer, const display::DirtyRegion &region) {
+  // we will only update the changed regions of the display, row by row
+  uint8_t line[2 * 320];
+  for (const auto &rect : region) {
+    this->set_addr_window_(rect.x1, rect.y1, rect.width(), rect.height());
+    this->start_data_();
+    for (int row = rect.y1; row < rect.y2; row++) {
+      const uint8_t *src = buffer + row * this->width_ + rect.x1;
+      uint8_t *dst = line;
+      for (int col = rect.x1; col < rect.x2; col++) {
+        const uint16_t color = this->convert_to_16bit_color_(*src++);
+        *dst++ = color >> 8;
+        *dst++ = color;
+      }
+      this->write_array(line, rect.width() * 2);
+    }
+    this->end_data_();
+  }
 }
 
 uint16_t ILI9341Display::convert_to_16bit_color_(uint8_t color_8bit) {
@@ -129,13 +174,9 @@ uint8_t ILI9341Display::convert_to_8bit_color_(uint16_t color_16bit) {
   return ((b / 0x0A) | ((g / 0x09) << 2) | ((r / 0x04) << 5));
 }
 
-void ILI9341Display::fill(Color color) {
+void ILI9341Display::fill_buffer_internal(Color color) {
   auto color565 = display::ColorUtil::color_to_565(color);
   memset(this->buffer_, convert_to_8bit_color_(color565), this->get_buffer_length_());
-  this->x_low_ = 0;
-  this->y_low_ = 0;
-  this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
 }
 
 void ILI9341Display::fill_internal_(Color color) {
@@ -155,16 +196,20 @@ void HOT ILI9341Display::draw_absolute_pixel_internal(int x, int y, Color color)
   if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0)
     return;
 
-  // low and high watermark may speed up drawing from buffer
-  this->x_low_ = (x < this->x_low_) ? x : this->x_low_;
-  this->y_low_ = (y < this->y_low_) ? y : this->y_low_;
-  this->x_high_ = (x > this->x_high_) ? x : this->x_high_;
-  this->y_high_ = (y > this->y_high_) ? y : this->y_high_;
-
   uint32_t pos = (y * width_) + x;
   auto color565 = display::ColorUtil::color_to_565(color);
   buffer_[pos] = convert_to_8bit_color_(color565);
 }
+void HOT ILI9341Display::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  const uint8_t color8 = this->convert_to_8bit_color_(display::ColorUtil::color_to_565(color));
+  for (int row = y; row < y + height; row++)
+    memset(this->buffer_ + row * this->width_ + x, color8, width);
+}
+void HOT ILI9341Display::draw_absolute_row_internal(int x, int y, int width, const Color *colors) {
+  uint8_t *ptr = this->buffer_ + y * this->width_ + x;
+  for (int i = 0; i < width; i++)
+    *ptr++ = this->convert_to_8bit_color_(display::ColorUtil::color_to_565(colors[i]));
+}
 
 // should return the total size: return this->get_width_internal() * this->get_height_internal() * 2 // 16bit color
 // values per bit is huge
@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/components/spi/spi.h"
 #include "esphome/components/display/display_buffer.h"
+#include "esphome/components/display/flush_task.h"
 #include "ili9341_defines.h"
 #include "ili9341_init.h"
 
@@ -24,6 +25,16 @@ class ILI9341Display : public PollingComponent,
   void set_reset_pin(GPIOPin *reset) { this->reset_pin_ = reset; }
   void set_led_pin(GPIOPin *led) { this->led_pin_ = led; }
   void set_model(ILI9341Model model) { this->model_ = model; }
+  /// Send the frames to the display in a background task while the next frame is drawn (ESP32 only).
+  void set_async_flush(bool async_flush) { this->async_flush_ = async_flush; }
+#ifdef ARDUINO_ARCH_ESP32
+  /// Duration of the last background flush in microseconds, 0 if frames are sent synchronously.
+  uint32_t get_flush_time() const { return this->flush_task_ != nullptr ? this->flush_task_->get_flush_time() : 0; }
+  /// How long the last background flush ran in parallel to the loop, in microseconds.
+  uint32_t get_flush_overlap_time() const {
+    return this->flush_task_ != nullptr ? this->flush_task_->get_overlap_time() : 0;
+  }
+#endif
 
   void command(uint8_t value);
   void data(uint8_t value);
@@ -33,16 +44,20 @@ class ILI9341Display : public PollingComponent,
 
   void update() override;
 
-  void fill(Color color) override;
+  void fill_buffer_internal(Color color) override;
 
   void dump_config() override;
   void setup() override {
     this->setup_pins_();
     this->initialize();
+    this->enable_dirty_tracking_();
+    this->setup_flush_task_();
   }
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rect_internal(int x, int y, int width, int height, Color color) override;
+  void draw_absolute_row_internal(int x, int y, int width, const Color *colors) override;
   void setup_pins_();
 
   void init_lcd_(const uint8_t *init_cmd);
@@ -50,17 +65,15 @@ class ILI9341Display : public PollingComponent,
   void invert_display_(bool invert);
   void reset_();
   void fill_internal_(Color color);
-  void display_();
+  void setup_flush_task_();
+  /// Send the regions of the buffer to the display.
+  void display_(const uint8_t *buffer, const display::DirtyRegion &region);
   uint16_t convert_to_16bit_color_(uint8_t color_8bit);
   uint8_t convert_to_8bit_color_(uint16_t color_16bit);
 
   ILI9341Model model_;
   int16_t width_{320};   ///< Display width as modified by current rotation
   int16_t height_{240};  ///< Display height as modified by current rotation
-  uint16_t x_low_{0};
-  uint16_t y_low_{0};
-  uint16_t x_high_{0};
-  uint16_t y_high_{0};
 
   uint32_t get_buffer_length_();
   int get_width_internal() override;
@@ -75,6 +88,14 @@ class ILI9341Display : public PollingComponent,
   GPIOPin *led_pin_{nullptr};
   GPIOPin *dc_pin_;
   GPIOPin *busy_pin_{nullptr};
+
+  bool async_flush_{false};
+#ifdef ARDUINO_ARCH_ESP32
+  display::FlushTask *flush_task_{nullptr};
+  /// The copy of the buffer that's sent by the flush task, and the regions it sends.
+  uint8_t *flush_buffer_{nullptr};
+  display::DirtyRegion flush_region_;
+#endif
 };
 
 //-----------   M5Stack display --------------
@@ -86,7 +86,8 @@ size_t Inkplate6::get_buffer_length_() {
   }
 }
 void Inkplate6::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
 
   if (this->full_update_every_ > 0 && this->partial_updates_ >= this->full_update_every_) {
     this->block_partial_ = true;
@@ -198,7 +199,7 @@ void Inkplate6::eink_on_() {
   this->ckv_pin_->digital_write(false);
   this->oe_pin_->digital_write(true);
 }
-void Inkplate6::fill(Color color) {
+void Inkplate6::fill_buffer_internal(Color color) {
   ESP_LOGV(TAG, "Fill called");
   unsigned long start_time = millis();
 
@@ -66,7 +66,7 @@ class Inkplate6 : public PollingComponent, public display::DisplayBuffer, public
 
   void display();
   void clean();
-  void fill(Color color) override;
+  void fill_buffer_internal(Color color) override;
 
   void update() override;
 
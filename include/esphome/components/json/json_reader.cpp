@@ -0,0 +1,214 @@
+#include "json_reader.h"
+#include "esphome/core/helpers.h"
+#include <cctype>
+
+namespace esphome {
+namespace json {
+
+/// Maximum nesting of skipped objects and arrays, deeper documents are rejected to bound the stack usage.
+static const uint8_t MAX_SKIP_DEPTH = 16;
+
+bool JsonReader::begin_object() {
+  if (this->error_)
+    return false;
+  if (!this->consume_('{'))
+    return this->fail_();
+  this->after_member_ = false;
+  return true;
+}
+bool JsonReader::next_key() {
+  if (this->error_)
+    return false;
+  if (this->consume_('}')) {
+    // the object was a member of the enclosing object
+    this->after_member_ = true;
+    return false;
+  }
+  if (this->after_member_ && !this->consume_(','))
+    return this->fail_();
+  this->skip_whitespace_();
+  if (!this->parse_string_())
+    return false;
+  if (!this->consume_(':'))
+    return this->fail_();
+  return true;
+}
+bool JsonReader::read_string(std::string *value) {
+  if (this->error_)
+    return false;
+  this->skip_whitespace_();
+  if (this->pos_ != this->end_ && (*this->pos_ == '{' || *this->pos_ == '[')) {
+    // not a string, keep the reader in sync with the document
+    this->skip_value();
+    return false;
+  }
+  if (this->pos_ != this->end_ && *this->pos_ == '"') {
+    if (!this->parse_string_())
+      return false;
+  } else {
+    if (!this->parse_literal_())
+      return false;
+    if (this->string_ == "null") {
+      this->after_member_ = true;
+      return false;
+    }
+  }
+  this->after_member_ = true;
+  *value = this->string_;
+  return true;
+}
+bool JsonReader::read_float(float *value) {
+  std::string str;
+  if (!this->read_string(&str))
+    return false;
+  auto parsed = parse_float(str);
+  if (!parsed.has_value())
+    return false;
+  *value = *parsed;
+  return true;
+}
+bool JsonReader::read_bool(bool *value) {
+  std::string str;
+  if (!this->read_string(&str))
+    return false;
+  if (str != "true" && str != "false")
+    return false;
+  *value = str == "true";
+  return true;
+}
+bool JsonReader::skip_value() {
+  if (this->error_)
+    return false;
+  this->skip_whitespace_();
+  if (this->pos_ == this->end_)
+    return this->fail_();
+
+  const char c = *this->pos_;
+  if (c == '{' || c == '[') {
+    if (this->skip_depth_ == MAX_SKIP_DEPTH)
+      return this->fail_();
+    this->skip_depth_++;
+    if (c == '{') {
+      this->begin_object();
+      while (this->next_key())
+        this->skip_value();
+    } else {
+      this->pos_++;
+      if (!this->consume_(']')) {
+        do {
+          this->skip_value();
+        } while (!this->error_ && this->consume_(','));
+        if (!this->error_ && !this->consume_(']'))
+          this->fail_();
+      }
+    }
+    this->skip_depth_--;
+  } else if (c == '"') {
+    this->parse_string_();
+  } else {
+    this->parse_literal_();
+  }
+  this->after_member_ = true;
+  return !this->error_;
+}
+
+void JsonReader::skip_whitespace_() {
+  while (this->pos_ != this->end_ &&
+         (*this->pos_ == ' ' || *this->pos_ == '\t' || *this->pos_ == '\n' || *this->pos_ == '\r'))
+    this->pos_++;
+}
+bool JsonReader::consume_(char c) {
+  this->skip_whitespace_();
+  if (this->pos_ == this->end_ || *this->pos_ != c)
+    return false;
+  this->pos_++;
+  return true;
+}
+bool JsonReader::parse_string_() {
+  if (this->pos_ == this->end_ || *this->pos_ != '"')
+    return this->fail_();
+  this->pos_++;
+  this->string_.clear();
+  while (this->pos_ != this->end_) {
+    const char c = *this->pos_++;
+    if (c == '"')
+      return true;
+    if (c != '\\') {
+      this->string_ += c;
+      continue;
+    }
+    if (this->pos_ == this->end_)
+      break;
+    const char escaped = *this->pos_++;
+    switch (escaped) {
+      case 'b':
+        this->string_ += '\b';
+        break;
+      case 'f':
+        this->string_ += '\f';
+        break;
+      case 'n':
+        this->string_ += '\n';
+        break;
+      case 'r':
+        this->string_ += '\r';
+        break;
+      case 't':
+        this->string_ += '\t';
+        break;
+      case 'u': {
+        if (this->end_ - this->pos_ < 4)
+          return this->fail_();
+        uint32_t code = 0;
+        for (uint8_t i = 0; i < 4; i++) {
+          const char h = *this->pos_++;
+          code <<= 4;
+          if (h >= '0' && h <= '9') {
+            code |= h - '0';
+          } else if ((h | 0x20) >= 'a' && (h | 0x20) <= 'f') {
+            code |= (h | 0x20) - 'a' + 10;
+          } else {
+            return this->fail_();
+          }
+        }
+        // Encode as UTF-8, surrogate pairs are not combined
+        if (code < 0x80) {
+          this->string_ += char(code);
+        } else if (code < 0x800) {
+          this->string_ += char(0xC0 | (code >> 6));
+          this->string_ += char(0x80 | (code & 0x3F));
+        } else {
+          this->string_ += char(0xE0 | (code >> 12));
+          this->string_ += char(0x80 | ((code >> 6) & 0x3F));
+          this->string_ += char(0x80 | (code & 0x3F));
+        }
+        break;
+      }
+      default:
+        // '"', '\\' and '/'
+        this->string_ += escaped;
+        break;
+    }
+  }
+  // unterminated string
+  return this->fail_();
+}
+bool JsonReader::parse_literal_() {
+  const char *start = this->pos_;
+  while (this->pos_ != this->end_ && (isalnum(*this->pos_) || *this->pos_ == '-' || *this->pos_ == '+' ||
+                                      *this->pos_ == '.'))
+    this->pos_++;
+  if (this->pos_ == start)
+    return this->fail_();
+  this->string_.assign(start, this->pos_ - start);
+  if (isalpha(*start) && this->string_ != "true" && this->string_ != "false" && this->string_ != "null")
+    return this->fail_();
+  return true;
+}
+bool JsonReader::fail_() {
+  this->error_ = true;
+  return false;
+}
+
+}  // namespace json
+}  // namespace esphome
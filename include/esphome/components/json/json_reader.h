@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace esphome {
+namespace json {
+
+/** Pull parser for JSON documents, reads values one by one without building a document.
+ *
+ * ```cpp
+ * JsonReader reader(payload);
+ * if (reader.begin_object()) {
+ *   while (reader.next_key()) {
+ *     if (reader.key_is("brightness")) {
+ *       float brightness;
+ *       if (reader.read_float(&brightness))
+ *         call.set_brightness(brightness / 255.0f);
+ *     } else {
+ *       reader.skip_value();
+ *     }
+ *   }
+ * }
+ * if (reader.has_error())
+ *   ESP_LOGW(TAG, "Parsing JSON failed.");
+ * ```
+ *
+ * The input must stay valid while the reader is used. Only the current key or string value is copied.
+ */
+class JsonReader {
+ public:
+  JsonReader(const char *data, size_t length) : pos_(data), end_(data + length) {}
+  explicit JsonReader(const std::string &data) : JsonReader(data.data(), data.size()) {}
+
+  /// Read the start of an object, returns false if the next value isn't an object.
+  bool begin_object();
+  /** Read the next key of the current object.
+   *
+   * Returns false at the end of the object (which is consumed) or on errors. The value of the key must be read or
+   * skipped before the next call.
+   */
+  bool next_key();
+  /// Whether the key read by next_key() is equal to the given one.
+  bool key_is(const char *key) const { return this->string_ == key; }
+  /// The key read by next_key().
+  const std::string &get_key() const { return this->string_; }
+
+  /// Read a string value, numbers and booleans are returned as written.
+  bool read_string(std::string *value);
+  /// Read a number, strings that contain a number are accepted as well.
+  bool read_float(float *value);
+  bool read_bool(bool *value);
+  /// Skip the next value, including nested objects and arrays.
+  bool skip_value();
+
+  /// Whether the input isn't valid JSON, as far as it was read.
+  bool has_error() const { return this->error_; }
+
+ protected:
+  void skip_whitespace_();
+  /// Consume the given character after whitespace, returns false (without an error) if it's not there.
+  bool consume_(char c);
+  /// Read a quoted string into string_.
+  bool parse_string_();
+  /// Read a number, true, false or null into string_.
+  bool parse_literal_();
+  bool fail_();
+
+  const char *pos_;
+  const char *end_;
+  std::string string_;
+  /// Set after a member was read, the next key must be preceded by a comma.
+  bool after_member_{false};
+  /// Nesting of the objects and arrays skip_value() is in.
+  uint8_t skip_depth_{0};
+  bool error_{false};
+};
+
+}  // namespace json
+}  // namespace esphome
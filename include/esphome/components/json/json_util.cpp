@@ -8,6 +8,8 @@ static const char *const TAG = "json";
 
 static char *global_json_build_buffer = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 static size_t global_json_build_buffer_size = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+/// Keeps its capacity, after the first few calls write_json() doesn't allocate anymore.
+static std::string global_json_write_buffer;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 void reserve_global_json_build_buffer(size_t required_size) {
   if (global_json_build_buffer_size == 0 || global_json_build_buffer_size < required_size) {
@@ -46,6 +48,19 @@ const char *build_json(const json_build_t &f, size_t *length) {
   *length = bytes_written;
   return global_json_build_buffer;
 }
+const char *write_json(const json_write_t &f, size_t *length) {
+  global_json_write_buffer.clear();
+  JsonWriter writer(&global_json_write_buffer);
+  f(writer);
+  *length = global_json_write_buffer.size();
+  return global_json_write_buffer.c_str();
+}
+std::string write_json(const json_write_t &f) {
+  std::string out;
+  JsonWriter writer(&out);
+  f(writer);
+  return out;
+}
 void parse_json(const std::string &data, const json_parse_t &f) {
   global_json_buffer.clear();
   JsonObject &root = global_json_buffer.parseObject(data);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "esphome/core/helpers.h"
+#include "json_reader.h"
+#include "json_writer.h"
 #include <ArduinoJson.h>
 
 namespace esphome {
@@ -17,6 +19,14 @@ const char *build_json(const json_build_t &f, size_t *length);
 
 std::string build_json(const json_build_t &f);
 
+/// Callback function typedef for writing JSON without building a JsonObject first.
+using json_write_t = std::function<void(JsonWriter &)>;
+
+/// Write a JSON string with the provided json write function into a buffer that's reused by the next call.
+const char *write_json(const json_write_t &f, size_t *length);
+
+std::string write_json(const json_write_t &f);
+
 /// Parse a JSON string and run the provided json parse function if it's valid.
 void parse_json(const std::string &data, const json_parse_t &f);
 
@@ -0,0 +1,165 @@
+#include "json_writer.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace json {
+
+static const char *const TAG = "json";
+
+void JsonWriter::value(const char *value) {
+  if (value == nullptr) {
+    this->null_value();
+    return;
+  }
+  this->string_value_(value, strlen(value));
+}
+void JsonWriter::value(bool value) {
+  this->separator_();
+  if (value) {
+    this->write_("true", 4);
+  } else {
+    this->write_("false", 5);
+  }
+}
+void JsonWriter::value(long value) {
+  this->separator_();
+  char buffer[24];
+  int len = snprintf(buffer, sizeof(buffer), "%ld", value);
+  this->write_(buffer, len);
+}
+void JsonWriter::value(unsigned long value) {
+  this->separator_();
+  char buffer[24];
+  int len = snprintf(buffer, sizeof(buffer), "%lu", value);
+  this->write_(buffer, len);
+}
+void JsonWriter::value(long long value) {
+  this->separator_();
+  char buffer[24];
+  int len = snprintf(buffer, sizeof(buffer), "%lld", value);
+  this->write_(buffer, len);
+}
+void JsonWriter::value(unsigned long long value) {
+  this->separator_();
+  char buffer[24];
+  int len = snprintf(buffer, sizeof(buffer), "%llu", value);
+  this->write_(buffer, len);
+}
+void JsonWriter::null_value() {
+  this->separator_();
+  this->write_("null", 4);
+}
+
+void JsonWriter::begin_(char c) {
+  if (this->skipped_depth_ != 0 || this->depth_ == JSON_WRITER_MAX_DEPTH) {
+    if (this->skipped_depth_ == 0) {
+      // the bits of first_ can't track deeper levels, write the whole object/array as null instead
+      this->null_value();
+      if (!this->error_)
+        ESP_LOGE(TAG, "JSON is nested deeper than %u levels, replacing the contents with null!", JSON_WRITER_MAX_DEPTH);
+      this->error_ = true;
+    }
+    this->skipped_depth_++;
+    return;
+  }
+  this->separator_();
+  this->write_(c);
+  this->depth_++;
+  this->first_ |= 1UL << this->depth_;
+}
+void JsonWriter::end_(char c) {
+  if (this->skipped_depth_ != 0) {
+    this->skipped_depth_--;
+    return;
+  }
+  this->depth_--;
+  this->write_(c);
+}
+void JsonWriter::key_(const char *key, size_t len) {
+  this->separator_();
+  this->write_('"');
+  this->write_(key, len);
+  this->write_("\":", 2);
+  this->after_key_ = true;
+}
+void JsonWriter::separator_() {
+  if (this->after_key_) {
+    this->after_key_ = false;
+    return;
+  }
+  const uint32_t bit = 1UL << this->depth_;
+  if ((this->first_ & bit) == 0)
+    this->write_(',');
+  this->first_ &= ~bit;
+}
+void JsonWriter::string_value_(const char *value, size_t len) {
+  this->separator_();
+  this->write_('"');
+  const char *start = value;
+  const char *end = value + len;
+  for (const char *it = value; it != end; it++) {
+    const auto c = static_cast<uint8_t>(*it);
+    if (c >= 0x20 && c != '"' && c != '\\')
+      continue;
+
+    // Write everything up to the character that needs escaping in one go
+    this->write_(start, it - start);
+    start = it + 1;
+    switch (c) {
+      case '"':
+        this->write_("\\\"", 2);
+        break;
+      case '\\':
+        this->write_("\\\\", 2);
+        break;
+      case '\n':
+        this->write_("\\n", 2);
+        break;
+      case '\r':
+        this->write_("\\r", 2);
+        break;
+      case '\t':
+        this->write_("\\t", 2);
+        break;
+      default: {
+        char buffer[7];
+        snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+        this->write_(buffer, 6);
+        break;
+      }
+    }
+  }
+  this->write_(start, end - start);
+  this->write_('"');
+}
+void JsonWriter::number_value_(double value, int precision) {
+  if (std::isnan(value) || std::isinf(value)) {
+    this->null_value();
+    return;
+  }
+  this->separator_();
+  char buffer[32];
+  int len = snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+  this->write_(buffer, len);
+}
+void JsonWriter::write_(const char *data, size_t len) {
+  if (this->skipped_depth_ != 0)
+    return;
+  if (this->string_ != nullptr) {
+    this->string_->append(data, len);
+  } else if (this->print_ != nullptr) {
+    this->print_->write(reinterpret_cast<const uint8_t *>(data), len);
+  } else if (this->length_ + 1 < this->capacity_) {
+    const size_t fits = std::min(len, this->capacity_ - 1 - this->length_);
+    memcpy(this->buffer_ + this->length_, data, fits);
+    this->buffer_[this->length_ + fits] = '\0';
+  }
+  this->length_ += len;
+}
+
+}  // namespace json
+}  // namespace esphome
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Arduino.h"
+
+namespace esphome {
+namespace json {
+
+/// The maximum nesting depth of objects and arrays, deeper ones are written as null.
+static const uint8_t JSON_WRITER_MAX_DEPTH = 31;
+
+/** Streaming JSON writer that emits directly into a buffer, string or stream, without building a document first.
+ *
+ * Values are written in the order of the calls, commas and quotes are inserted automatically:
+ *
+ * ```cpp
+ * writer.begin_object();
+ * writer.member("id", "sensor-" + obj->get_object_id());
+ * writer.member("value", state);
+ * writer.end_object();
+ * ```
+ *
+ * Keys are passed as string literals, their length is known at compile time and they are written without escaping.
+ * Objects and arrays can be nested up to JSON_WRITER_MAX_DEPTH levels, deeper ones are replaced by null and
+ * has_error() is set.
+ */
+class JsonWriter {
+ public:
+  /// Append to a string.
+  explicit JsonWriter(std::string *out) : string_(out) {}
+  /// Write into a fixed size buffer, the output is null-terminated and truncated if it doesn't fit.
+  JsonWriter(char *buffer, size_t capacity) : buffer_(buffer), capacity_(capacity) {
+    if (capacity != 0)
+      buffer[0] = '\0';
+  }
+  /// Write to a stream, for example an AsyncResponseStream.
+  explicit JsonWriter(Print *out) : print_(out) {}
+
+  void begin_object() { this->begin_('{'); }
+  void end_object() { this->end_('}'); }
+  void begin_array() { this->begin_('['); }
+  void end_array() { this->end_(']'); }
+
+  /// Start a member of the current object, followed by its value or a nested object/array.
+  template<size_t N> void key(const char (&key)[N]) { this->key_(key, N - 1); }
+
+  void value(const char *value);
+  void value(const std::string &value) { this->string_value_(value.data(), value.size()); }
+  void value(bool value);
+  void value(int value) { this->value(static_cast<long>(value)); }
+  void value(unsigned value) { this->value(static_cast<unsigned long>(value)); }
+  void value(long value);
+  void value(unsigned long value);
+  void value(long long value);
+  void value(unsigned long long value);
+  /// Write a number with up to 7 significant digits, NaN and infinity are written as null.
+  void value(float value) { this->number_value_(value, 7); }
+  /// Write a number with up to 15 significant digits, NaN and infinity are written as null.
+  void value(double value) { this->number_value_(value, 15); }
+  void null_value();
+
+  /// Write a key and its value.
+  template<size_t N, typename T> void member(const char (&key)[N], const T &value) {
+    this->key_(key, N - 1);
+    this->value(value);
+  }
+  template<size_t N> void member(const char (&key)[N], const char *value) {
+    this->key_(key, N - 1);
+    this->value(value);
+  }
+
+  /// Number of bytes written, including the ones that didn't fit into a fixed size buffer.
+  size_t length() const { return this->length_; }
+  /// Whether the output was truncated because the fixed size buffer was too small.
+  bool overflowed() const { return this->buffer_ != nullptr && this->length_ >= this->capacity_; }
+  /// Whether objects or arrays were nested deeper than JSON_WRITER_MAX_DEPTH, their contents are missing then.
+  bool has_error() const { return this->error_; }
+
+ protected:
+  void begin_(char c);
+  void end_(char c);
+  void key_(const char *key, size_t len);
+  /// Write the comma in front of an array element or object member, if it isn't the first one.
+  void separator_();
+  void string_value_(const char *value, size_t len);
+  void number_value_(double value, int precision);
+  void write_(const char *data, size_t len);
+  void write_(char c) { this->write_(&c, 1); }
+
+  std::string *string_{nullptr};
+  Print *print_{nullptr};
+  char *buffer_{nullptr};
+  size_t capacity_{0};
+  size_t length_{0};
+  /// Bit n is set while nothing has been written at nesting depth n.
+  uint32_t first_{1};
+  uint8_t depth_{0};
+  /// Number of open objects/arrays past the maximum depth, nothing is written until they are closed.
+  uint32_t skipped_depth_{0};
+  bool error_{false};
+  /// A key was written, the next value must not be preceded by a comma.
+  bool after_key_{false};
+};
+
+}  // namespace json
+}  // namespace esphome
@@ -1,5 +1,6 @@
 #include "addressable_light.h"
 #include "esphome/core/log.h"
+#include <cstring>
 
 namespace esphome {
 namespace light {
@@ -24,6 +25,51 @@ void AddressableLight::call_setup() {
 #endif
 }
 
+void HOT AddressableLight::write_colors(int32_t offset, const Color *colors, int32_t count) {
+  ESPRawPixels raw{};
+  if (!this->get_raw_pixels_internal(&raw)) {
+    for (int32_t i = 0; i < count; i++)
+      this->get_view_internal(offset + i).set(colors[i]);
+    return;
+  }
+  this->correction_.correct_into(colors, count, raw.data + offset * raw.stride, raw.stride, raw.offsets);
+}
+
+void HOT AddressableLight::fill_colors(int32_t from, int32_t to, const Color &color) {
+  ESPRawPixels raw{};
+  if (!this->get_raw_pixels_internal(&raw)) {
+    for (int32_t i = from; i < to; i++)
+      this->get_view_internal(i).set(color);
+    return;
+  }
+  // correct the color once and copy its bytes to every LED
+  uint8_t pixel[4];
+  this->correction_.correct_into(&color, 1, pixel, raw.stride, raw.offsets);
+  uint8_t *out = raw.data + from * raw.stride;
+  for (int32_t i = from; i < to; i++, out += raw.stride)
+    memcpy(out, pixel, raw.stride);
+}
+
+void AddressableLight::read_effect_data(int32_t offset, uint8_t *data, int32_t count) const {
+  ESPRawPixels raw{};
+  if (!this->get_raw_pixels_internal(&raw)) {
+    for (int32_t i = 0; i < count; i++)
+      data[i] = this->get_view_internal(offset + i).get_effect_data();
+    return;
+  }
+  memcpy(data, raw.effect_data + offset, count);
+}
+
+void AddressableLight::write_effect_data(int32_t offset, const uint8_t *data, int32_t count) {
+  ESPRawPixels raw{};
+  if (!this->get_raw_pixels_internal(&raw)) {
+    for (int32_t i = 0; i < count; i++)
+      this->get_view_internal(offset + i).set_effect_data(data[i]);
+    return;
+  }
+  memcpy(raw.effect_data + offset, data, count);
+}
+
 Color esp_color_from_light_color_values(LightColorValues val) {
   auto r = static_cast<uint8_t>(roundf(val.get_red() * 255.0f));
   auto g = static_cast<uint8_t>(roundf(val.get_green() * 255.0f));
@@ -35,7 +81,11 @@ Color esp_color_from_light_color_values(LightColorValues val) {
 void AddressableLight::write_state(LightState *state) {
   auto val = state->current_values;
   auto max_brightness = static_cast<uint8_t>(roundf(val.get_brightness() * val.get_state() * 255.0f));
-  this->correction_.set_local_brightness(max_brightness);
+  const bool transition = !this->is_effect_active() && state->transformer_ != nullptr &&
+                          state->transformer_->is_transition();
+  // our transition will handle brightness, disable brightness in correction. Set it only once, the correction
+  // tables are recalculated whenever it changes.
+  this->correction_.set_local_brightness(transition ? 255 : max_brightness);
 
   this->last_transition_progress_ = 0.0f;
   this->accumulated_alpha_ = 0.0f;
@@ -45,7 +95,7 @@ void AddressableLight::write_state(LightState *state) {
 
   // don't use LightState helper, gamma correction+brightness is handled by ESPColorView
 
-  if (state->transformer_ == nullptr || !state->transformer_->is_transition()) {
+  if (!transition) {
     // no transformer active or non-transition one
     this->all() = esp_color_from_light_color_values(val);
   } else {
@@ -66,8 +116,6 @@ void AddressableLight::write_state(LightState *state) {
     auto end_values = state->transformer_->get_end_values();
     Color target_color = esp_color_from_light_color_values(end_values);
 
-    // our transition will handle brightness, disable brightness in correction.
-    this->correction_.set_local_brightness(255);
     uint8_t orig_w = target_color.w;
     target_color *= static_cast<uint8_t>(roundf(end_values.get_brightness() * end_values.get_state() * 255.0f));
     // w is not scaled by brightness
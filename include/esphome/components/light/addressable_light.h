@@ -18,6 +18,17 @@ namespace light {
 
 using ESPColor = Color;
 
+/// The pixel buffer of a driver in its native byte order, see AddressableLight::get_raw_pixels_internal().
+struct ESPRawPixels {
+  /// The bytes of the first LED, every LED takes `stride` bytes.
+  uint8_t *data;
+  uint8_t stride;
+  /// The positions of the red, green, blue and white bytes within an LED. White is only used with a stride of 4.
+  uint8_t offsets[4];
+  /// One byte of effect data per LED.
+  uint8_t *effect_data;
+};
+
 class AddressableLight : public LightOutput, public Component {
  public:
   virtual int32_t size() const = 0;
@@ -50,6 +61,19 @@ class AddressableLight : public LightOutput, public Component {
       amnt = this->size();
     this->range(amnt, this->size()) = this->range(0, -amnt);
   }
+
+  /** Correct `count` colors and write them to the LEDs starting at `offset`, in one pass.
+   *
+   * Much faster than setting the LEDs one by one through the views: effects can render into a small buffer of
+   * colors and write it at once, the colors go straight into the buffer of the driver.
+   */
+  void write_colors(int32_t offset, const Color *colors, int32_t count);
+  /// Set the LEDs from `from` up to (excluding) `to` to one color.
+  void fill_colors(int32_t from, int32_t to, const Color &color);
+  /// Read/write the effect data of `count` LEDs starting at `offset`.
+  void read_effect_data(int32_t offset, uint8_t *data, int32_t count) const;
+  void write_effect_data(int32_t offset, const uint8_t *data, int32_t count);
+
   bool is_effect_active() const { return this->effect_active_; }
   void set_effect_active(bool effect_active) { this->effect_active_ = effect_active; }
   void write_state(LightState *state) override;
@@ -84,6 +108,9 @@ class AddressableLight : public LightOutput, public Component {
 #endif
   }
   virtual ESPColorView get_view_internal(int32_t index) const = 0;
+  /// Describe the pixel buffer for the bulk accessors. Outputs without one plain buffer return false, then the bulk
+  /// accessors go through the views.
+  virtual bool get_raw_pixels_internal(ESPRawPixels *raw) const { return false; }
 
   bool effect_active_{false};
   bool next_show_{true};
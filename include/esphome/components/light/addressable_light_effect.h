@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <utility>
 
 #include "esphome/core/component.h"
@@ -27,6 +28,10 @@ inline static int16_t sin16_c(uint16_t theta) {
 }
 inline static uint8_t half_sin8(uint8_t v) { return sin16_c(uint16_t(v) * 128u) >> 8; }
 
+/// Effects render this many LEDs at a time into a buffer on the stack and write them with
+/// AddressableLight::write_colors().
+static const int32_t ADDRESSABLE_EFFECT_CHUNK_SIZE = 32;
+
 class AddressableLightEffect : public LightEffect {
  public:
   explicit AddressableLightEffect(const std::string &name) : LightEffect(name) {}
@@ -82,10 +87,15 @@ class AddressableRainbowLightEffect : public AddressableLightEffect {
     hsv.saturation = 240;
     uint16_t hue = (millis() * this->speed_) % 0xFFFF;
     const uint16_t add = 0xFFFF / this->width_;
-    for (auto var : it) {
-      hsv.hue = hue >> 8;
-      var = hsv;
-      hue += add;
+    Color colors[ADDRESSABLE_EFFECT_CHUNK_SIZE];
+    for (int32_t offset = 0; offset < it.size(); offset += ADDRESSABLE_EFFECT_CHUNK_SIZE) {
+      const int32_t count = std::min(it.size() - offset, ADDRESSABLE_EFFECT_CHUNK_SIZE);
+      for (int32_t i = 0; i < count; i++) {
+        hsv.hue = hue >> 8;
+        colors[i] = hsv.to_rgb();
+        hue += add;
+      }
+      it.write_colors(offset, colors, count);
     }
   }
   void set_speed(uint32_t speed) { this->speed_ = speed; }
@@ -191,18 +201,24 @@ class AddressableTwinkleEffect : public AddressableLightEffect {
       pos_add = pos_add32;
       this->last_progress_ += pos_add32 * this->progress_interval_;
     }
-    for (auto view : addressable) {
-      if (view.get_effect_data() != 0) {
-        const uint8_t sine = half_sin8(view.get_effect_data());
-        view = current_color * sine;
-        const uint8_t new_pos = view.get_effect_data() + pos_add;
-        if (new_pos < view.get_effect_data())
-          view.set_effect_data(0);
-        else
-          view.set_effect_data(new_pos);
-      } else {
-        view = COLOR_BLACK;
+    Color colors[ADDRESSABLE_EFFECT_CHUNK_SIZE];
+    uint8_t effect_data[ADDRESSABLE_EFFECT_CHUNK_SIZE];
+    for (int32_t offset = 0; offset < addressable.size(); offset += ADDRESSABLE_EFFECT_CHUNK_SIZE) {
+      const int32_t count = std::min(addressable.size() - offset, ADDRESSABLE_EFFECT_CHUNK_SIZE);
+      addressable.read_effect_data(offset, effect_data, count);
+      for (int32_t i = 0; i < count; i++) {
+        const uint8_t pos = effect_data[i];
+        if (pos != 0) {
+          const uint8_t sine = half_sin8(pos);
+          colors[i] = current_color * sine;
+          const uint8_t new_pos = pos + pos_add;
+          effect_data[i] = new_pos < pos ? 0 : new_pos;
+        } else {
+          colors[i] = COLOR_BLACK;
+        }
       }
+      addressable.write_colors(offset, colors, count);
+      addressable.write_effect_data(offset, effect_data, count);
     }
     while (random_float() < this->twinkle_probability_) {
       const size_t pos = random_uint32() % addressable.size();
@@ -231,24 +247,32 @@ class AddressableRandomTwinkleEffect : public AddressableLightEffect {
       this->last_progress_ = now;
     }
     uint8_t subsine = ((8 * (now - this->last_progress_)) / this->progress_interval_) & 0b111;
-    for (auto view : it) {
-      if (view.get_effect_data() != 0) {
-        const uint8_t x = (view.get_effect_data() >> 3) & 0b11111;
-        const uint8_t color = view.get_effect_data() & 0b111;
-        const uint16_t sine = half_sin8((x << 3) | subsine);
-        if (color == 0) {
-          view = current_color * sine;
+    Color colors[ADDRESSABLE_EFFECT_CHUNK_SIZE];
+    uint8_t effect_data[ADDRESSABLE_EFFECT_CHUNK_SIZE];
+    for (int32_t offset = 0; offset < it.size(); offset += ADDRESSABLE_EFFECT_CHUNK_SIZE) {
+      const int32_t count = std::min(it.size() - offset, ADDRESSABLE_EFFECT_CHUNK_SIZE);
+      it.read_effect_data(offset, effect_data, count);
+      for (int32_t i = 0; i < count; i++) {
+        if (effect_data[i] != 0) {
+          const uint8_t x = (effect_data[i] >> 3) & 0b11111;
+          const uint8_t color = effect_data[i] & 0b111;
+          const uint16_t sine = half_sin8((x << 3) | subsine);
+          if (color == 0) {
+            colors[i] = current_color * sine;
+          } else {
+            colors[i] = Color(((color >> 2) & 1) * sine, ((color >> 1) & 1) * sine, ((color >> 0) & 1) * sine);
+          }
+          const uint8_t new_x = x + pos_add;
+          if (new_x > 0b11111)
+            effect_data[i] = 0;
+          else
+            effect_data[i] = (new_x << 3) | color;
         } else {
-          view = Color(((color >> 2) & 1) * sine, ((color >> 1) & 1) * sine, ((color >> 0) & 1) * sine);
+          colors[i] = Color(0, 0, 0, 0);
         }
-        const uint8_t new_x = x + pos_add;
-        if (new_x > 0b11111)
-          view.set_effect_data(0);
-        else
-          view.set_effect_data((new_x << 3) | color);
-      } else {
-        view = Color(0, 0, 0, 0);
       }
+      it.write_colors(offset, colors, count);
+      it.write_effect_data(offset, effect_data, count);
     }
     while (random_float() < this->twinkle_probability_) {
       const size_t pos = random_uint32() % it.size();
@@ -10,6 +10,7 @@ void ESPColorCorrection::calculate_gamma_table(float gamma) {
     auto corrected = static_cast<uint8_t>(roundf(255.0f * gamma_correct(i / 255.0f, gamma)));
     this->gamma_table_[i] = corrected;
   }
+  this->calculate_correction_tables_();
   if (gamma == 0.0f) {
     for (uint16_t i = 0; i < 256; i++)
       this->gamma_reverse_table_[i] = i;
@@ -22,5 +23,42 @@ void ESPColorCorrection::calculate_gamma_table(float gamma) {
   }
 }
 
+void ESPColorCorrection::calculate_correction_tables_() {
+  for (uint16_t i = 0; i < 256; i++) {
+    this->correction_table_[0][i] =
+        this->gamma_table_[esp_scale8(esp_scale8(i, this->max_brightness_.red), this->local_brightness_)];
+    this->correction_table_[1][i] =
+        this->gamma_table_[esp_scale8(esp_scale8(i, this->max_brightness_.green), this->local_brightness_)];
+    this->correction_table_[2][i] =
+        this->gamma_table_[esp_scale8(esp_scale8(i, this->max_brightness_.blue), this->local_brightness_)];
+    // do not scale white value with brightness
+    this->correction_table_[3][i] = this->gamma_table_[esp_scale8(i, this->max_brightness_.white)];
+  }
+}
+
+void HOT ESPColorCorrection::correct_into(const Color *colors, size_t count, uint8_t *out, uint8_t stride,
+                                          const uint8_t *offsets) const {
+  const uint8_t *red = this->correction_table_[0];
+  const uint8_t *green = this->correction_table_[1];
+  const uint8_t *blue = this->correction_table_[2];
+  const uint8_t *white = this->correction_table_[3];
+  const uint8_t red_offset = offsets[0], green_offset = offsets[1], blue_offset = offsets[2];
+  if (stride >= 4) {
+    const uint8_t white_offset = offsets[3];
+    for (const Color *end = colors + count; colors != end; colors++, out += stride) {
+      out[red_offset] = red[colors->red];
+      out[green_offset] = green[colors->green];
+      out[blue_offset] = blue[colors->blue];
+      out[white_offset] = white[colors->white];
+    }
+  } else {
+    for (const Color *end = colors + count; colors != end; colors++, out += stride) {
+      out[red_offset] = red[colors->red];
+      out[green_offset] = green[colors->green];
+      out[blue_offset] = blue[colors->blue];
+    }
+  }
+}
+
 }  // namespace light
 }  // namespace esphome
@@ -7,32 +7,33 @@ namespace light {
 
 class ESPColorCorrection {
  public:
-  ESPColorCorrection() : max_brightness_(255, 255, 255, 255) {}
-  void set_max_brightness(const Color &max_brightness) { this->max_brightness_ = max_brightness; }
-  void set_local_brightness(uint8_t local_brightness) { this->local_brightness_ = local_brightness; }
+  ESPColorCorrection() : max_brightness_(255, 255, 255, 255) { this->calculate_correction_tables_(); }
+  void set_max_brightness(const Color &max_brightness) {
+    this->max_brightness_ = max_brightness;
+    this->calculate_correction_tables_();
+  }
+  void set_local_brightness(uint8_t local_brightness) {
+    if (this->local_brightness_ == local_brightness)
+      return;
+    this->local_brightness_ = local_brightness;
+    this->calculate_correction_tables_();
+  }
   void calculate_gamma_table(float gamma);
   inline Color color_correct(Color color) const ALWAYS_INLINE {
     // corrected = (uncorrected * max_brightness * local_brightness) ^ gamma
     return Color(this->color_correct_red(color.red), this->color_correct_green(color.green),
                  this->color_correct_blue(color.blue), this->color_correct_white(color.white));
   }
-  inline uint8_t color_correct_red(uint8_t red) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(red, this->max_brightness_.red), this->local_brightness_);
-    return this->gamma_table_[res];
-  }
-  inline uint8_t color_correct_green(uint8_t green) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(green, this->max_brightness_.green), this->local_brightness_);
-    return this->gamma_table_[res];
-  }
-  inline uint8_t color_correct_blue(uint8_t blue) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(blue, this->max_brightness_.blue), this->local_brightness_);
-    return this->gamma_table_[res];
-  }
-  inline uint8_t color_correct_white(uint8_t white) const ALWAYS_INLINE {
-    // do not scale white value with brightness
-    uint8_t res = esp_scale8(white, this->max_brightness_.white);
-    return this->gamma_table_[res];
-  }
+  inline uint8_t color_correct_red(uint8_t red) const ALWAYS_INLINE { return this->correction_table_[0][red]; }
+  inline uint8_t color_correct_green(uint8_t green) const ALWAYS_INLINE { return this->correction_table_[1][green]; }
+  inline uint8_t color_correct_blue(uint8_t blue) const ALWAYS_INLINE { return this->correction_table_[2][blue]; }
+  inline uint8_t color_correct_white(uint8_t white) const ALWAYS_INLINE { return this->correction_table_[3][white]; }
+  /** Correct `count` colors and write them into a pixel buffer in one pass.
+   *
+   * Every LED takes `stride` bytes of the buffer, `offsets` are the positions of the red, green, blue and white
+   * bytes within it. White is only written if the stride is at least 4.
+   */
+  void correct_into(const Color *colors, size_t count, uint8_t *out, uint8_t stride, const uint8_t *offsets) const;
   inline Color color_uncorrect(Color color) const ALWAYS_INLINE {
     // uncorrected = corrected^(1/gamma) / (max_brightness * local_brightness)
     return Color(this->color_uncorrect_red(color.red), this->color_uncorrect_green(color.green),
@@ -68,8 +69,13 @@ class ESPColorCorrection {
   }
 
  protected:
-  uint8_t gamma_table_[256];
+  /// Combine gamma, max brightness and local brightness into one lookup table per channel.
+  void calculate_correction_tables_();
+
+  uint8_t gamma_table_[256]{};
   uint8_t gamma_reverse_table_[256];
+  /// corrected = correction_table_[channel][uncorrected], for red, green, blue and white.
+  uint8_t correction_table_[4][256];
   Color max_brightness_;
   uint8_t local_brightness_{255};
 };
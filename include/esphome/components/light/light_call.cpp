@@ -8,22 +8,24 @@ namespace light {
 static const char *const TAG = "light";
 
 #ifdef USE_JSON
+void LightCall::parse_state_(const char *state) {
+  switch (parse_on_off(state)) {
+    case PARSE_ON:
+      this->set_state(true);
+      break;
+    case PARSE_OFF:
+      this->set_state(false);
+      break;
+    case PARSE_TOGGLE:
+      this->set_state(!this->parent_->remote_values.is_on());
+      break;
+    case PARSE_NONE:
+      break;
+  }
+}
 LightCall &LightCall::parse_color_json(JsonObject &root) {
   if (root.containsKey("state")) {
-    auto val = parse_on_off(root["state"]);
-    switch (val) {
-      case PARSE_ON:
-        this->set_state(true);
-        break;
-      case PARSE_OFF:
-        this->set_state(false);
-        break;
-      case PARSE_TOGGLE:
-        this->set_state(!this->parent_->remote_values.is_on());
-        break;
-      case PARSE_NONE:
-        break;
-    }
+    this->parse_state_(root["state"]);
   }
 
   if (root.containsKey("brightness")) {
@@ -73,6 +75,58 @@ LightCall &LightCall::parse_json(JsonObject &root) {
 
   return *this;
 }
+LightCall &LightCall::parse_json(json::JsonReader &reader) {
+  if (!reader.begin_object())
+    return *this;
+
+  std::string str;
+  float value;
+  while (reader.next_key()) {
+    if (reader.key_is("state")) {
+      if (reader.read_string(&str))
+        this->parse_state_(str.c_str());
+    } else if (reader.key_is("brightness")) {
+      if (reader.read_float(&value))
+        this->set_brightness(value / 255.0f);
+    } else if (reader.key_is("color")) {
+      if (!reader.begin_object())
+        break;
+      while (reader.next_key()) {
+        if (reader.key_is("r")) {
+          if (reader.read_float(&value))
+            this->set_red(value / 255.0f);
+        } else if (reader.key_is("g")) {
+          if (reader.read_float(&value))
+            this->set_green(value / 255.0f);
+        } else if (reader.key_is("b")) {
+          if (reader.read_float(&value))
+            this->set_blue(value / 255.0f);
+        } else {
+          reader.skip_value();
+        }
+      }
+    } else if (reader.key_is("white_value")) {
+      if (reader.read_float(&value))
+        this->set_white(value / 255.0f);
+    } else if (reader.key_is("color_temp")) {
+      if (reader.read_float(&value))
+        this->set_color_temperature(value);
+    } else if (reader.key_is("flash")) {
+      if (reader.read_float(&value))
+        this->set_flash_length(uint32_t(value * 1000));
+    } else if (reader.key_is("transition")) {
+      if (reader.read_float(&value))
+        this->set_transition_length(uint32_t(value * 1000));
+    } else if (reader.key_is("effect")) {
+      if (reader.read_string(&str))
+        this->set_effect(str);
+    } else {
+      reader.skip_value();
+    }
+  }
+
+  return *this;
+}
 #endif
 
 void LightCall::perform() {
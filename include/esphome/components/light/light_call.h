@@ -128,6 +128,8 @@ class LightCall {
 #ifdef USE_JSON
   LightCall &parse_color_json(JsonObject &root);
   LightCall &parse_json(JsonObject &root);
+  /// Read the same JSON schema as parse_json(JsonObject &) directly from the payload, without building a document.
+  LightCall &parse_json(json::JsonReader &reader);
 #endif
   LightCall &from_light_color_values(const LightColorValues &values);
 
@@ -137,6 +139,10 @@ class LightCall {
   /// Validate all properties and return the target light color values.
   LightColorValues validate_();
 
+#ifdef USE_JSON
+  void parse_state_(const char *state);
+#endif
+
   bool has_transition_() { return this->transition_length_.has_value(); }
   bool has_flash_() { return this->flash_length_.has_value(); }
   bool has_effect_() { return this->effect_.has_value(); }
@@ -11,6 +11,52 @@
 namespace esphome {
 namespace light {
 
+/// Number of segments of the gamma lookup table of LightGamma.
+static const uint8_t LIGHT_GAMMA_TABLE_SEGMENTS = 64;
+
+/** The gamma correction applied when converting LightColorValues to output values.
+ *
+ * With calculate_table() the correction is looked up in a table and interpolated between its entries with integer
+ * math, instead of calling powf() for every channel on every update. Converts implicitly from a plain gamma value,
+ * which is then applied with gamma_correct().
+ */
+class LightGamma {
+ public:
+  LightGamma(float gamma = 0.0f) : gamma_(gamma) {}  // NOLINT
+
+  float get_gamma() const { return this->gamma_; }
+
+  /// Calculate the lookup table for the gamma value.
+  void calculate_table() {
+    this->has_table_ = this->gamma_ > 0.0f;
+    for (uint8_t i = 0; this->has_table_ && i <= LIGHT_GAMMA_TABLE_SEGMENTS; i++) {
+      float corrected = gamma_correct(i / float(LIGHT_GAMMA_TABLE_SEGMENTS), this->gamma_);
+      this->table_[i] = static_cast<uint16_t>(roundf(corrected * 65535.0f));
+    }
+  }
+
+  float correct(float value) const {
+    if (!this->has_table_)
+      return gamma_correct(value, this->gamma_);
+    if (value <= 0.0f)
+      return 0.0f;
+    if (value >= 1.0f)
+      return 1.0f;
+    // 16 bit fixed point, the upper bits select the segment and the lower bits interpolate within it
+    const uint32_t fixed = static_cast<uint32_t>(value * 65536.0f);
+    const uint32_t index = fixed >> 10;
+    const uint32_t fraction = fixed & 0x3FF;
+    const uint32_t start = this->table_[index];
+    const uint32_t corrected = start + (((this->table_[index + 1] - start) * fraction) >> 10);
+    return corrected * (1.0f / 65535.0f);
+  }
+
+ protected:
+  float gamma_;
+  bool has_table_{false};
+  uint16_t table_[LIGHT_GAMMA_TABLE_SEGMENTS + 1];
+};
+
 /** This class represents the color state for a light object.
  *
  * All values in this class are represented using floats in the range from 0.0 (off) to 1.0 (on).
@@ -174,37 +220,38 @@ class LightColorValues {
   void as_binary(bool *binary) const { *binary = this->state_ == 1.0f; }
 
   /// Convert these light color values to a brightness-only representation and write them to brightness.
-  void as_brightness(float *brightness, float gamma = 0) const {
-    *brightness = gamma_correct(this->state_ * this->brightness_, gamma);
+  void as_brightness(float *brightness, const LightGamma &gamma = 0.0f) const {
+    *brightness = gamma.correct(this->state_ * this->brightness_);
   }
 
   /// Convert these light color values to an RGB representation and write them to red, green, blue.
-  void as_rgb(float *red, float *green, float *blue, float gamma = 0, bool color_interlock = false) const {
+  void as_rgb(float *red, float *green, float *blue, const LightGamma &gamma = 0.0f,
+              bool color_interlock = false) const {
     float brightness = this->state_ * this->brightness_;
     if (color_interlock) {
       brightness = brightness * (1.0f - this->white_);
     }
-    *red = gamma_correct(brightness * this->red_, gamma);
-    *green = gamma_correct(brightness * this->green_, gamma);
-    *blue = gamma_correct(brightness * this->blue_, gamma);
+    *red = gamma.correct(brightness * this->red_);
+    *green = gamma.correct(brightness * this->green_);
+    *blue = gamma.correct(brightness * this->blue_);
   }
 
   /// Convert these light color values to an RGBW representation and write them to red, green, blue, white.
-  void as_rgbw(float *red, float *green, float *blue, float *white, float gamma = 0,
+  void as_rgbw(float *red, float *green, float *blue, float *white, const LightGamma &gamma = 0.0f,
                bool color_interlock = false) const {
     this->as_rgb(red, green, blue, gamma, color_interlock);
-    *white = gamma_correct(this->state_ * this->brightness_ * this->white_, gamma);
+    *white = gamma.correct(this->state_ * this->brightness_ * this->white_);
   }
 
   /// Convert these light color values to an RGBWW representation with the given parameters.
   void as_rgbww(float color_temperature_cw, float color_temperature_ww, float *red, float *green, float *blue,
-                float *cold_white, float *warm_white, float gamma = 0, bool constant_brightness = false,
+                float *cold_white, float *warm_white, const LightGamma &gamma = 0.0f, bool constant_brightness = false,
                 bool color_interlock = false) const {
     this->as_rgb(red, green, blue, gamma, color_interlock);
     const float color_temp = clamp(this->color_temperature_, color_temperature_cw, color_temperature_ww);
     const float ww_fraction = (color_temp - color_temperature_cw) / (color_temperature_ww - color_temperature_cw);
     const float cw_fraction = 1.0f - ww_fraction;
-    const float white_level = gamma_correct(this->state_ * this->brightness_ * this->white_, gamma);
+    const float white_level = gamma.correct(this->state_ * this->brightness_ * this->white_);
     *cold_white = white_level * cw_fraction;
     *warm_white = white_level * ww_fraction;
     if (!constant_brightness) {
@@ -216,11 +263,11 @@ class LightColorValues {
 
   /// Convert these light color values to an CWWW representation with the given parameters.
   void as_cwww(float color_temperature_cw, float color_temperature_ww, float *cold_white, float *warm_white,
-               float gamma = 0, bool constant_brightness = false) const {
+               const LightGamma &gamma = 0.0f, bool constant_brightness = false) const {
     const float color_temp = clamp(this->color_temperature_, color_temperature_cw, color_temperature_ww);
     const float ww_fraction = (color_temp - color_temperature_cw) / (color_temperature_ww - color_temperature_cw);
     const float cw_fraction = 1.0f - ww_fraction;
-    const float white_level = gamma_correct(this->state_ * this->brightness_ * this->white_, gamma);
+    const float white_level = gamma.correct(this->state_ * this->brightness_ * this->white_);
     *cold_white = white_level * cw_fraction;
     *warm_white = white_level * ww_fraction;
     if (!constant_brightness) {
@@ -111,7 +111,7 @@ class LightState : public Nameable, public Component {
 
   /// Set the gamma correction factor
   void set_gamma_correct(float gamma_correct);
-  float get_gamma_correct() const { return this->gamma_correct_; }
+  float get_gamma_correct() const { return this->gamma_correct_.get_gamma(); }
 
   /// Set the restore mode of this light
   void set_restore_mode(LightRestoreMode restore_mode);
@@ -195,7 +195,8 @@ class LightState : public Nameable, public Component {
   /// Default transition length for all transitions in ms.
   uint32_t default_transition_length_{};
   /// Gamma correction factor for the light.
-  float gamma_correct_{};
+  /// The gamma correction, with its lookup table.
+  LightGamma gamma_correct_{};
   /// Restore mode of the light.
   LightRestoreMode restore_mode_;
   /// List of effects for this light.
@@ -58,17 +58,68 @@ class LightTransitionTransformer : public LightTransformer {
       this->start_values_.set_white(target_values.get_white());
       this->start_values_.set_color_temperature(target_values.get_color_temperature());
     }
+
+    // precompute the start values and the deltas to the target in 16.16 fixed point, so that rendering a step of
+    // the transition only takes a few integer operations per channel
+    const LightColorValues &start = this->start_values_;
+    const LightColorValues &target = this->target_values_;
+    this->set_channel_(0, start.get_state(), target.get_state());
+    this->set_channel_(1, start.get_brightness(), target.get_brightness());
+    this->set_channel_(2, start.get_red(), target.get_red());
+    this->set_channel_(3, start.get_green(), target.get_green());
+    this->set_channel_(4, start.get_blue(), target.get_blue());
+    this->set_channel_(5, start.get_white(), target.get_white());
+    this->set_channel_(6, start.get_color_temperature(), target.get_color_temperature());
+    // progress per millisecond in 0.32 fixed point
+    this->progress_step_ = (uint64_t(1) << 32) / std::max(length, uint32_t(1));
   }
 
   LightColorValues get_values() override {
-    float v = LightTransitionTransformer::smoothed_progress(this->get_progress());
-    return LightColorValues::lerp(this->get_start_values_(), this->get_target_values_(), v);
+    const int32_t v = LightTransitionTransformer::smoothed_progress_fixed(this->get_progress_fixed_());
+    LightColorValues values;
+    values.set_state(this->interpolate_(0, v));
+    values.set_brightness(this->interpolate_(1, v));
+    values.set_red(this->interpolate_(2, v));
+    values.set_green(this->interpolate_(3, v));
+    values.set_blue(this->interpolate_(4, v));
+    values.set_white(this->interpolate_(5, v));
+    values.set_color_temperature(this->interpolate_(6, v));
+    return values;
   }
 
+  bool is_finished() override { return millis() - this->start_time_ >= this->length_; }
   bool publish_at_end() override { return false; }
   bool is_transition() override { return true; }
 
   static float smoothed_progress(float x) { return x * x * x * (x * (x * 6.0f - 15.0f) + 10.0f); }
+  /// smoothed_progress() in 16.16 fixed point, x from 0 to 65536.
+  static int32_t smoothed_progress_fixed(int32_t x) {
+    const int64_t poly = ((int64_t(x) * (6 * int64_t(x) - (int64_t(15) << 16))) >> 16) + (int64_t(10) << 16);
+    const int64_t cube = (((int64_t(x) * x) >> 16) * x) >> 16;
+    return (cube * poly) >> 16;
+  }
+
+ protected:
+  /// The progress of the transition in 16.16 fixed point, from 0 to 65536.
+  int32_t get_progress_fixed_() const {
+    const uint32_t elapsed = millis() - this->start_time_;
+    if (elapsed >= this->length_)
+      return 1 << 16;
+    return (elapsed * this->progress_step_) >> 16;
+  }
+  void set_channel_(uint8_t channel, float start, float target) {
+    this->start_fixed_[channel] = static_cast<int32_t>(roundf(start * 65536.0f));
+    this->delta_fixed_[channel] = static_cast<int32_t>(roundf(target * 65536.0f)) - this->start_fixed_[channel];
+  }
+  float interpolate_(uint8_t channel, int32_t completion) const {
+    const int32_t value = this->start_fixed_[channel] + ((int64_t(this->delta_fixed_[channel]) * completion) >> 16);
+    return value * (1.0f / 65536.0f);
+  }
+
+  /// State, brightness, red, green, blue, white and color temperature at the start, and their change until the end.
+  int32_t start_fixed_[7];
+  int32_t delta_fixed_[7];
+  uint64_t progress_step_;
 };
 
 class LightFlashTransformer : public LightTransformer {
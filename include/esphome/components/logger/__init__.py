@@ -97,7 +97,30 @@ LoggerMessageTrigger = logger_ns.class_(
     automation.Trigger.template(cg.int_, cg.const_char_ptr, cg.const_char_ptr),
 )
 
+def validate_ring_buffer_size(value):
+    value = cv.validate_bytes(value)
+    if value == 0:
+        return value
+    if value & (value - 1) != 0 or not 1024 <= value <= 32768:
+        raise cv.Invalid(
+            "ring_buffer_size must be 0 or a power of two between 1kB and 32kB"
+        )
+    return value
+
+
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_RING_BUFFER_SIZE = "ring_buffer_size"
+CONF_DEFERRED_FORMAT = "deferred_format"
+
+
+def validate_deferred_format(config):
+    if config.get(CONF_DEFERRED_FORMAT) and not config.get(CONF_RING_BUFFER_SIZE):
+        raise cv.Invalid(
+            f"{CONF_DEFERRED_FORMAT} requires a non-zero {CONF_RING_BUFFER_SIZE}"
+        )
+    return config
+
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -120,9 +143,16 @@ CONFIG_SCHEMA = cv.All(
             cv.SplitDefault(
                 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH, esp8266=True
             ): cv.All(cv.only_on_esp8266, cv.boolean),
+            cv.SplitDefault(CONF_RING_BUFFER_SIZE, esp32="4kB"): cv.All(
+                cv.only_on_esp32, validate_ring_buffer_size
+            ),
+            cv.SplitDefault(CONF_DEFERRED_FORMAT, esp32=False): cv.All(
+                cv.only_on_esp32, cv.boolean
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     validate_local_no_higher_than_global,
+    validate_deferred_format,
 )
 
 
@@ -135,6 +165,8 @@ async def to_code(config):
         HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]],
     )
     log = cg.Pvariable(config[CONF_ID], rhs)
+    if CONF_RING_BUFFER_SIZE in config:
+        cg.add(log.set_ring_buffer_size(config[CONF_RING_BUFFER_SIZE]))
     cg.add(log.pre_setup())
 
     for tag, level in config[CONF_LOGS].items():
@@ -142,6 +174,8 @@ async def to_code(config):
 
     level = config[CONF_LEVEL]
     cg.add_define("USE_LOGGER")
+    if config.get(CONF_DEFERRED_FORMAT, False):
+        cg.add_define("USE_LOGGER_DEFERRED_FORMAT")
     this_severity = LOG_LEVEL_SEVERITY.index(level)
     cg.add_build_flag("-DESPHOME_LOG_LEVEL={}".format(LOG_LEVELS[level]))
 
@@ -1,15 +1,27 @@
 #include "logger.h"
+#include "esphome/core/application.h"
 
 #ifdef ARDUINO_ARCH_ESP32
 #include <esp_log.h>
 #endif
 #include <HardwareSerial.h>
+#include <cstddef>
 
 namespace esphome {
 namespace logger {
 
 static const char *const TAG = "logger";
 
+#ifdef ARDUINO_ARCH_ESP32
+/// The record is complete and can be written out.
+static const uint32_t RING_COMMITTED = 1UL << 31;
+/// The record only skips the space up to the end of the ring buffer.
+static const uint32_t RING_PADDING = 1UL << 30;
+/// The message holds a format string pointer and the arguments encoded by DeferredLogEncoder.
+static const uint32_t RING_DEFERRED = 1UL << 29;
+static const uint32_t RING_SIZE_MASK = 0xFFFF;
+#endif
+
 static const char *const LOG_LEVEL_COLORS[] = {
     "",                                            // NONE
     ESPHOME_LOG_BOLD(ESPHOME_LOG_COLOR_RED),       // ERROR
@@ -46,6 +58,16 @@ void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *
   if (level > this->level_for(tag))
     return;
 
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->ring_ != nullptr) {
+    this->ring_write_(level, tag, line, format, args);
+    return;
+  }
+#endif
+
+  this->log_vprintf_sync_(level, tag, line, format, args);
+}
+void HOT Logger::log_vprintf_sync_(int level, const char *tag, int line, const char *format, va_list args) {
   this->reset_buffer_();
   this->write_header_(level, tag, line);
   this->vprintf_to_buffer_(format, args);
@@ -81,6 +103,240 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
 }
 #endif
 
+#ifdef ARDUINO_ARCH_ESP32
+Logger::RingRecord *HOT Logger::ring_reserve_(uint32_t len) {
+  const uint32_t size = ring_record_size_(len);
+  if (size > this->ring_size_)
+    return nullptr;
+
+  // Records are never split, skip the rest of the ring buffer if this one doesn't fit there
+  const uint32_t mask = this->ring_size_ - 1;
+  uint32_t head = this->ring_head_.load(std::memory_order_relaxed);
+  uint32_t padding;
+  uint32_t next;
+  do {
+    const uint32_t offset = head & mask;
+    padding = offset + size > this->ring_size_ ? this->ring_size_ - offset : 0;
+    next = head + padding + size;
+    if (next - this->ring_tail_.load(std::memory_order_acquire) > this->ring_size_)
+      return nullptr;
+  } while (!this->ring_head_.compare_exchange_weak(head, next, std::memory_order_relaxed));
+
+  if (padding != 0) {
+    auto *skip = reinterpret_cast<RingRecord *>(&this->ring_[head & mask]);
+    __atomic_store_n(&skip->header, RING_COMMITTED | RING_PADDING | padding, __ATOMIC_RELEASE);
+  }
+  return reinterpret_cast<RingRecord *>(&this->ring_[(head + padding) & mask]);
+}
+Logger::RingRecord *HOT Logger::ring_reserve_or_drop_(uint32_t len) {
+  auto *record = this->ring_reserve_(len);
+  if (record == nullptr && this->is_loop_task_() && !this->ring_draining_) {
+    // The loop task can make room itself, unless it is already writing out the ring buffer
+    this->ring_drain_();
+    record = this->ring_reserve_(len);
+  }
+  if (record == nullptr)
+    this->ring_dropped_.fetch_add(1, std::memory_order_relaxed);
+  return record;
+}
+void HOT Logger::ring_commit_(RingRecord *record, uint32_t len, uint32_t flags) {
+  const uint32_t size = ring_record_size_(len);
+  __atomic_store_n(&record->header, RING_COMMITTED | flags | size, __ATOMIC_RELEASE);
+  if (!this->is_loop_task_())
+    App.wake_loop();
+}
+void HOT Logger::ring_write_(int level, const char *tag, int line, const char *format, va_list args) {
+  va_list arg;
+  va_copy(arg, args);
+  int len = vsnprintf(nullptr, 0, format, arg);
+  va_end(arg);
+  if (len < 0)
+    // Encoding error, nothing to log
+    return;
+  // the header is added when writing out, longer messages would be truncated then anyway
+  if (len > this->tx_buffer_size_)
+    len = this->tx_buffer_size_;
+
+  auto *record = this->ring_reserve_or_drop_(len + 1);
+  if (record == nullptr)
+    return;
+  record->tag = tag;
+  record->line = line;
+  record->level = level;
+  va_copy(arg, args);
+  vsnprintf(record->message, len + 1, format, arg);
+  va_end(arg);
+  this->ring_commit_(record, len + 1, 0);
+}
+void HOT Logger::ring_drain_() {
+  this->ring_draining_ = true;
+  const uint32_t mask = this->ring_size_ - 1;
+  uint32_t tail = this->ring_tail_.load(std::memory_order_relaxed);
+  const uint32_t head = this->ring_head_.load(std::memory_order_acquire);
+  while (tail != head) {
+    auto *record = reinterpret_cast<RingRecord *>(&this->ring_[tail & mask]);
+    const uint32_t header = __atomic_load_n(&record->header, __ATOMIC_ACQUIRE);
+    if ((header & RING_COMMITTED) == 0)
+      // Still being written by another task, wait for it to keep the order of messages
+      break;
+
+    const uint32_t size = header & RING_SIZE_MASK;
+    if ((header & RING_PADDING) == 0) {
+      this->reset_buffer_();
+      this->write_header_(record->level, record->tag, record->line);
+      if ((header & RING_DEFERRED) != 0) {
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+        const char *format;
+        memcpy(&format, record->message, sizeof(const char *));
+        const auto *args = reinterpret_cast<const uint8_t *>(record->message) + sizeof(const char *);
+        this->deferred_to_buffer_(format, args, reinterpret_cast<const uint8_t *>(record) + size);
+#endif
+      } else {
+        this->write_to_buffer_(record->message, strlen(record->message));
+      }
+      this->write_footer_();
+      this->log_message_(record->level, record->tag);
+    }
+    // Free space must read as not committed, a new record header can start anywhere in it
+    memset(record, 0, size);
+    tail += size;
+    this->ring_tail_.store(tail, std::memory_order_release);
+  }
+
+  const uint32_t dropped = this->ring_dropped_.exchange(0, std::memory_order_relaxed);
+  if (dropped != 0) {
+    this->reset_buffer_();
+    this->write_header_(ESPHOME_LOG_LEVEL_WARN, TAG, __LINE__);
+    this->printf_to_buffer_("Dropped %u log messages, the ring buffer was full", dropped);
+    this->write_footer_();
+    this->log_message_(ESPHOME_LOG_LEVEL_WARN, TAG);
+  }
+  this->ring_draining_ = false;
+}
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+uint8_t *HOT Logger::deferred_begin_(int level, const char *tag, int line, const char *format, size_t len) {
+  auto *record = this->ring_reserve_or_drop_(sizeof(const char *) + len);
+  if (record == nullptr)
+    return nullptr;
+  record->tag = tag;
+  record->line = line;
+  record->level = level;
+  memcpy(record->message, &format, sizeof(const char *));
+  return reinterpret_cast<uint8_t *>(record->message) + sizeof(const char *);
+}
+void HOT Logger::deferred_end_(uint8_t *args, size_t len) {
+  auto *record = reinterpret_cast<RingRecord *>(args - sizeof(const char *) - offsetof(RingRecord, message));
+  this->ring_commit_(record, sizeof(const char *) + len, RING_DEFERRED);
+}
+void Logger::deferred_to_buffer_(const char *format, const uint8_t *args, const uint8_t *end) {
+  char spec[16];
+  while (*format != '\0' && !this->is_buffer_full_()) {
+    if (*format != '%') {
+      this->write_to_buffer_(*format++);
+      continue;
+    }
+    const char *start = format++;
+    if (*format == '%') {
+      this->write_to_buffer_(*format++);
+      continue;
+    }
+
+    // flags, width, precision and length modifier, '*' takes the value from the arguments
+    int32_t stars[2];
+    uint8_t num_stars = 0;
+    bool valid = true;
+    while (*format != '\0' && strchr("-+ #0123456789.*hlLjzt", *format) != nullptr) {
+      if (*format == '*') {
+        if (num_stars == 2 || end - args < 5 || *args != static_cast<uint8_t>(DeferredLogArg::INT32)) {
+          valid = false;
+        } else {
+          memcpy(&stars[num_stars++], args + 1, 4);
+          args += 5;
+        }
+      }
+      format++;
+    }
+    if (*format == '\0')
+      break;
+    const char conversion = *format++;
+    const size_t spec_len = format - start;
+    if (!valid || spec_len >= sizeof(spec) || args >= end) {
+      this->write_to_buffer_("<?>", 3);
+      continue;
+    }
+    memcpy(spec, start, spec_len);
+    spec[spec_len] = '\0';
+
+    const auto type = static_cast<DeferredLogArg>(args[0]);
+    size_t arg_len;
+    switch (type) {
+      case DeferredLogArg::INT32:
+        arg_len = 1 + 4;
+        break;
+      case DeferredLogArg::INT64:
+      case DeferredLogArg::DOUBLE:
+        arg_len = 1 + 8;
+        break;
+      case DeferredLogArg::STRING:
+        arg_len = args + 1 < end ? 1 + 1 + args[1] + 1 : end - args + 1;
+        break;
+      case DeferredLogArg::POINTER:
+        arg_len = 1 + sizeof(uintptr_t);
+        break;
+      default:
+        // padding or an unknown type, no more arguments can be decoded
+        arg_len = end - args + 1;
+        break;
+    }
+    if (arg_len > static_cast<size_t>(end - args)) {
+      args = end;
+      this->write_to_buffer_("<?>", 3);
+      continue;
+    }
+    const uint8_t *value = args + 1;
+    args += arg_len;
+
+    const bool is_string = conversion == 's';
+    const bool is_double = strchr("fFeEgGaA", conversion) != nullptr;
+    const bool is_pointer = conversion == 'p';
+    if (type == DeferredLogArg::INT32 && !is_string && !is_double && !is_pointer) {
+      int32_t raw;
+      memcpy(&raw, value, 4);
+      this->printf_arg_to_buffer_(spec, stars, num_stars, raw);
+    } else if (type == DeferredLogArg::INT64 && !is_string && !is_double && !is_pointer) {
+      int64_t raw;
+      memcpy(&raw, value, 8);
+      this->printf_arg_to_buffer_(spec, stars, num_stars, raw);
+    } else if (type == DeferredLogArg::DOUBLE && is_double) {
+      double raw;
+      memcpy(&raw, value, 8);
+      this->printf_arg_to_buffer_(spec, stars, num_stars, raw);
+    } else if (type == DeferredLogArg::STRING && is_string) {
+      this->printf_arg_to_buffer_(spec, stars, num_stars, reinterpret_cast<const char *>(value + 1));
+    } else if (type == DeferredLogArg::POINTER && is_pointer) {
+      uintptr_t raw;
+      memcpy(&raw, value, sizeof(uintptr_t));
+      this->printf_arg_to_buffer_(spec, stars, num_stars, reinterpret_cast<void *>(raw));
+    } else {
+      this->write_to_buffer_("<?>", 3);
+    }
+  }
+}
+#endif
+void Logger::loop() {
+  if (this->ring_ != nullptr)
+    this->ring_drain_();
+}
+bool Logger::can_loop_tickless() const {
+  // Other tasks wake the loop after logging
+  return this->ring_head_.load(std::memory_order_relaxed) == this->ring_tail_.load(std::memory_order_relaxed);
+}
+void Logger::on_shutdown() {
+  if (this->ring_ != nullptr)
+    this->ring_drain_();
+}
+#endif
+
 int HOT Logger::level_for(const char *tag) {
   // Uses std::vector<> for low memory footprint, though the vector
   // could be sorted to minimize lookup times. This feature isn't used that
@@ -159,6 +415,12 @@ void Logger::pre_setup() {
   }
 #endif
 
+#ifdef ARDUINO_ARCH_ESP32
+  this->loop_task_handle_ = xTaskGetCurrentTaskHandle();
+  if (this->ring_size_ != 0)
+    this->ring_ = new uint8_t[this->ring_size_]();
+#endif
+
   global_logger = this;
 #ifdef ARDUINO_ARCH_ESP32
   esp_log_set_vprintf(esp_idf_log_vprintf_);
@@ -174,7 +436,7 @@ void Logger::set_log_level(const std::string &tag, int log_level) {
   this->log_levels_.push_back(LogLevelOverride{tag, log_level});
 }
 UARTSelection Logger::get_uart() const { return this->uart_; }
-void Logger::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback) {
+void Logger::add_on_log_callback(InlineFunction<void(int, const char *, const char *)> &&callback) {
   this->log_callback_.add(std::move(callback));
 }
 float Logger::get_setup_priority() const { return setup_priority::HARDWARE - 1.0f; }
@@ -190,6 +452,9 @@ void Logger::dump_config() {
   ESP_LOGCONFIG(TAG, "  Level: %s", LOG_LEVELS[ESPHOME_LOG_LEVEL]);
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %u", this->baud_rate_);
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", UART_SELECTIONS[this->uart_]);
+#ifdef ARDUINO_ARCH_ESP32
+  ESP_LOGCONFIG(TAG, "  Ring Buffer Size: %u", this->ring_size_);
+#endif
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
   }
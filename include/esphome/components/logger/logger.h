@@ -6,6 +6,13 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/defines.h"
 
+#ifdef ARDUINO_ARCH_ESP32
+#include <atomic>
+#include <cstddef>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 namespace esphome {
 
 namespace logger {
@@ -40,16 +47,33 @@ class Logger : public Component {
   /// Set the log level of the specified tag.
   void set_log_level(const std::string &tag, int log_level);
 
+#ifdef ARDUINO_ARCH_ESP32
+  /** Set the size of the ring buffer (a power of two) log messages are queued in, 0 to disable queueing.
+   *
+   * With the ring buffer, logging only formats the message into the buffer, and loop() later writes it to
+   * serial and the log callbacks. Any task can log without blocking; if the buffer is full, the message is dropped.
+   * Must be called before pre_setup().
+   */
+  void set_ring_buffer_size(uint32_t ring_buffer_size) { this->ring_size_ = ring_buffer_size; }
+  /// Number of log messages that didn't fit into the ring buffer since the last report.
+  uint32_t get_dropped_messages() const { return this->ring_dropped_.load(std::memory_order_relaxed); }
+#endif
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Set up this component.
   void pre_setup();
   void dump_config() override;
+#ifdef ARDUINO_ARCH_ESP32
+  void loop() override;
+  bool can_loop_tickless() const override;
+  void on_shutdown() override;
+#endif
 
   int level_for(const char *tag);
 
   /// Register a callback that will be called for every log message sent
-  void add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback);
+  void add_on_log_callback(InlineFunction<void(int, const char *, const char *)> &&callback);
 
   float get_setup_priority() const override;
 
@@ -57,11 +81,61 @@ class Logger : public Component {
 #ifdef USE_STORE_LOG_STR_IN_FLASH
   void log_vprintf_(int level, const char *tag, int line, const __FlashStringHelper *format, va_list args);  // NOLINT
 #endif
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+  /// Whether a deferred log call with this level and tag is written, checked before its arguments are sized.
+  bool deferred_enabled_(int level, const char *tag) {  // NOLINT
+    return this->ring_ != nullptr && level <= this->level_for(tag);
+  }
+  /// Reserve a record for the raw arguments of a deferred log call, see esp_log_deferred_().
+  uint8_t *deferred_begin_(int level, const char *tag, int line, const char *format, size_t len);  // NOLINT
+  /// Publish a record reserved with deferred_begin_().
+  void deferred_end_(uint8_t *args, size_t len);  // NOLINT
+#endif
 
  protected:
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
+  void log_vprintf_sync_(int level, const char *tag, int line, const char *format, va_list args);
+
+#ifdef ARDUINO_ARCH_ESP32
+  /// Header of a record in the ring buffer, followed by the null terminated message.
+  struct RingRecord {
+    /// Size of the record including padding, plus the RING_* flags. Written last, with release order.
+    uint32_t header;
+    const char *tag;
+    uint16_t line;
+    uint8_t level;
+    char message[1];
+  };
+
+  bool is_loop_task_() const { return xTaskGetCurrentTaskHandle() == this->loop_task_handle_; }
+  static uint32_t ring_record_size_(uint32_t len) { return (offsetof(RingRecord, message) + len + 3) & ~3UL; }
+  /// Reserve space for a record with `len` bytes of message, returns nullptr if it doesn't fit.
+  RingRecord *ring_reserve_(uint32_t len);
+  /// Reserve space, making room first if called from the loop task. Counts the message as dropped on failure.
+  RingRecord *ring_reserve_or_drop_(uint32_t len);
+  /// Publish a reserved record with `len` bytes of message.
+  void ring_commit_(RingRecord *record, uint32_t len, uint32_t flags);
+  /// Format a message into the ring buffer.
+  void ring_write_(int level, const char *tag, int line, const char *format, va_list args);
+  /// Write out all complete records of the ring buffer, only called from the loop task.
+  void ring_drain_();
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+  /// Format the arguments stored by DeferredLogEncoder according to `format`.
+  void deferred_to_buffer_(const char *format, const uint8_t *args, const uint8_t *end);
+#endif
+
+  uint8_t *ring_{nullptr};
+  uint32_t ring_size_{0};
+  /// Position up to which space was reserved by producers, only grows.
+  std::atomic<uint32_t> ring_head_{0};
+  /// Position up to which records were written out and the space is free again.
+  std::atomic<uint32_t> ring_tail_{0};
+  std::atomic<uint32_t> ring_dropped_{0};
+  TaskHandle_t loop_task_handle_{nullptr};
+  bool ring_draining_{false};
+#endif
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -100,6 +174,18 @@ class Logger : public Component {
     this->vprintf_to_buffer_(format, arg);
     va_end(arg);
   }
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+  /// Format a single conversion specification, with the values of its '*' width and precision first.
+  template<typename T> void printf_arg_to_buffer_(const char *spec, const int32_t *stars, uint8_t num_stars, T value) {
+    if (num_stars == 0) {
+      this->printf_to_buffer_(spec, value);
+    } else if (num_stars == 1) {
+      this->printf_to_buffer_(spec, stars[0], value);
+    } else {
+      this->printf_to_buffer_(spec, stars[0], stars[1], value);
+    }
+  }
+#endif
 
   uint32_t baud_rate_;
   char *tx_buffer_{nullptr};
@@ -43,6 +43,10 @@ DEPENDENCIES = ["network"]
 AUTO_LOAD = ["json", "async_tcp"]
 
 
+CONF_PUBLISH_QUEUE_SIZE = "publish_queue_size"
+CONF_MAX_INFLIGHT = "max_inflight"
+
+
 def validate_message_just_topic(value):
     value = cv.publish_topic(value)
     return MQTT_MESSAGE_BASE({CONF_TOPIC: value})
@@ -170,6 +174,10 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_REBOOT_TIMEOUT, default="15min"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_PUBLISH_QUEUE_SIZE, default=32): cv.int_range(
+                min=1, max=1024
+            ),
+            cv.Optional(CONF_MAX_INFLIGHT, default=4): cv.int_range(min=1, max=64),
             cv.Optional(CONF_ON_MESSAGE): automation.validate_automation(
                 {
                     cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(MQTTMessageTrigger),
@@ -273,6 +281,8 @@ async def to_code(config):
     cg.add(var.set_keep_alive(config[CONF_KEEPALIVE]))
 
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    cg.add(var.set_publish_queue_size(config[CONF_PUBLISH_QUEUE_SIZE]))
+    cg.add(var.set_max_inflight(config[CONF_MAX_INFLIGHT]))
 
     for conf in config.get(CONF_ON_MESSAGE, []):
         trig = cg.new_Pvariable(conf[CONF_TRIGGER_ID], conf[CONF_TOPIC])
@@ -25,6 +25,9 @@ MQTTClientComponent::MQTTClientComponent() {
 // Connection
 void MQTTClientComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up MQTT...");
+  this->inflight_ids_.reset(new std::atomic<uint16_t>[this->max_inflight_]);
+  for (uint8_t i = 0; i < this->max_inflight_; i++)
+    this->inflight_ids_[i] = 0;
   this->mqtt_client_.onMessage([this](char *topic, char *payload, AsyncMqttClientMessageProperties properties,
                                       size_t len, size_t index, size_t total) {
     if (index == 0)
@@ -42,6 +45,20 @@ void MQTTClientComponent::setup() {
   this->mqtt_client_.onDisconnect([this](AsyncMqttClientDisconnectReason reason) {
     this->state_ = MQTT_CLIENT_DISCONNECTED;
     this->disconnect_reason_ = reason;
+    // unacknowledged messages are not resent by the MQTT client
+    for (uint8_t i = 0; i < this->max_inflight_; i++)
+      this->inflight_ids_[i] = 0;
+    this->unmatched_ack_ = 0;
+  });
+  this->mqtt_client_.onPublish([this](uint16_t packet_id) {
+    if (this->release_inflight_slot_(packet_id))
+      return;
+    // the loop may not have stored the packet id yet, leave it to send_message_() unless it did in the meantime
+    this->unmatched_ack_ = packet_id;
+    if (this->release_inflight_slot_(packet_id)) {
+      uint16_t expected = packet_id;
+      this->unmatched_ack_.compare_exchange_strong(expected, 0);
+    }
   });
 #ifdef USE_LOGGER
   if (this->is_log_message_enabled() && logger::global_logger != nullptr) {
@@ -54,6 +71,16 @@ void MQTTClientComponent::setup() {
   }
 #endif
 
+  if (!this->availability_.topic.empty() && this->birth_message_.retain) {
+    // The broker sends the retained availability message when subscribing. If it doesn't, it lost the retained
+    // messages and all discovery messages have to be sent again.
+    this->subscribe(this->availability_.topic, [this](const std::string &topic, const std::string &payload) {
+      if (this->retained_state_ == MQTT_RETAINED_CHECKING)
+        this->retained_state_ = MQTT_RETAINED_INTACT;
+    });
+    this->retained_state_ = MQTT_RETAINED_LOST;
+  }
+
   this->last_connected_ = millis();
   this->start_dnslookup_();
 }
@@ -74,6 +101,8 @@ void MQTTClientComponent::dump_config() {
   if (!this->availability_.topic.empty()) {
     ESP_LOGCONFIG(TAG, "  Availability: '%s'", this->availability_.topic.c_str());
   }
+  ESP_LOGCONFIG(TAG, "  Publish Queue Size: %u", this->publish_queue_size_);
+  ESP_LOGCONFIG(TAG, "  Max Inflight Messages: %u", this->max_inflight_);
 }
 bool MQTTClientComponent::can_proceed() { return this->is_connected(); }
 
@@ -208,6 +237,10 @@ void MQTTClientComponent::check_connected() {
 
   this->state_ = MQTT_CLIENT_CONNECTED;
   this->sent_birth_message_ = false;
+  if (this->retained_state_ != MQTT_RETAINED_UNKNOWN) {
+    this->retained_state_ = MQTT_RETAINED_CHECKING;
+    this->retained_check_start_ = millis();
+  }
   this->status_clear_warning();
   ESP_LOGI(TAG, "MQTT Connected!");
   // MQTT Client needs some time to be fully set up.
@@ -278,15 +311,23 @@ void MQTTClientComponent::loop() {
         ESP_LOGW(TAG, "Lost MQTT Client connection!");
         this->start_dnslookup_();
       } else {
-        if (!this->birth_message_.topic.empty() && !this->sent_birth_message_) {
+        if (this->retained_state_ == MQTT_RETAINED_CHECKING && now - this->retained_check_start_ > 2000) {
+          ESP_LOGD(TAG, "Broker has no retained availability message, sending all discovery messages.");
+          this->retained_state_ = MQTT_RETAINED_LOST;
+        }
+        // the birth message would be received as the retained message, wait for the check to complete
+        if (!this->birth_message_.topic.empty() && !this->sent_birth_message_ &&
+            this->retained_state_ != MQTT_RETAINED_CHECKING) {
           this->sent_birth_message_ = this->publish(this->birth_message_);
         }
 
         this->last_connected_ = now;
         this->resubscribe_subscriptions_();
+        this->process_publish_queue_();
       }
       break;
   }
+  this->report_publish_dropped_();
 
   if (millis() - this->last_connected_ > this->reboot_timeout_ && this->reboot_timeout_ != 0) {
     ESP_LOGE(TAG, "Can't connect to MQTT... Restarting...");
@@ -384,29 +425,138 @@ bool MQTTClientComponent::publish(const std::string &topic, const std::string &p
 
 bool MQTTClientComponent::publish(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos,
                                   bool retain) {
+  return this->publish_(topic, payload, payload_length, qos, retain, false);
+}
+bool MQTTClientComponent::publish_state(const std::string &topic, const char *payload, size_t payload_length,
+                                        uint8_t qos, bool retain) {
+  return this->publish_(topic, payload, payload_length, qos, retain, true);
+}
+bool MQTTClientComponent::publish_(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos,
+                                   bool retain, bool state) {
   if (!this->is_connected()) {
     // critical components will re-transmit their messages
     return false;
   }
-  bool logging_topic = topic == this->log_message_.topic;
-  uint16_t ret = this->mqtt_client_.publish(topic.c_str(), qos, retain, payload, payload_length);
-  delay(0);
-  if (ret == 0 && !logging_topic && this->is_connected()) {
-    delay(0);
-    ret = this->mqtt_client_.publish(topic.c_str(), qos, retain, payload, payload_length);
-    delay(0);
+
+  if (topic == this->log_message_.topic) {
+    // log messages are best effort, queueing them would only delay the other messages
+    return this->send_message_(topic.c_str(), payload, payload_length, qos, retain);
   }
 
-  if (!logging_topic) {
-    if (ret != 0) {
-      ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d)", topic.c_str(), payload, retain);
-    } else {
-      ESP_LOGV(TAG, "Publish failed for topic='%s' (len=%u). will retry later..", topic.c_str(),
-               payload_length);  // NOLINT
-      this->status_momentary_warning("publish", 1000);
+  // only the latest state is relevant, replace it if one is still waiting
+  if (state) {
+    for (auto &queued : this->publish_queue_) {
+      MQTTMessage &message = queued.message;
+      if (queued.state && message.topic == topic && message.qos == qos && message.retain == retain) {
+        message.payload.assign(payload, payload_length);
+        ESP_LOGV(TAG, "Publish(topic='%s') replaced queued state", topic.c_str());
+        return true;
+      }
     }
   }
-  return ret != 0;
+
+  // send right away if nothing is waiting, to keep the order of the messages
+  if (this->publish_queue_.empty() && this->send_message_(topic.c_str(), payload, payload_length, qos, retain)) {
+    ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d)", topic.c_str(), payload, retain);
+    return true;
+  }
+
+  if (this->publish_queue_.size() >= this->publish_queue_size_) {
+    this->publish_dropped_++;
+    ESP_LOGV(TAG, "Publish queue full, dropping topic='%s' (len=%u). will retry later..", topic.c_str(),
+             payload_length);  // NOLINT
+    this->status_momentary_warning("publish", 1000);
+    return false;
+  }
+
+  this->publish_queue_.push_back(MQTTQueuedMessage{
+      .message =
+          MQTTMessage{
+              .topic = topic,
+              .payload = std::string(payload, payload_length),
+              .qos = qos,
+              .retain = retain,
+          },
+      .state = state,
+  });
+  if (this->publish_queue_.size() > this->publish_queue_max_depth_)
+    this->publish_queue_max_depth_ = this->publish_queue_.size();
+  ESP_LOGV(TAG, "Queued publish for topic='%s' (len=%u, queued=%u)", topic.c_str(), payload_length,  // NOLINT
+           this->publish_queue_.size());
+  return true;
+}
+bool MQTTClientComponent::send_message_(const char *topic, const char *payload, size_t payload_length, uint8_t qos,
+                                        bool retain) {
+  std::atomic<uint16_t> *slot = nullptr;
+  if (qos > 0) {
+    slot = this->free_inflight_slot_();
+    if (slot == nullptr)
+      return false;
+  }
+
+  uint16_t ret = this->mqtt_client_.publish(topic, qos, retain, payload, payload_length);
+  delay(0);
+  if (ret == 0)
+    return false;
+
+  if (slot != nullptr) {
+    slot->store(ret);
+    // the acknowledgement may have arrived before the packet id was stored
+    uint16_t expected = ret;
+    if (this->unmatched_ack_.compare_exchange_strong(expected, 0))
+      this->release_inflight_slot_(ret);
+  }
+  return true;
+}
+void MQTTClientComponent::process_publish_queue_() {
+  // QoS 0 messages don't count against the inflight window, so they may pass QoS 1 and 2 messages waiting for it.
+  // Topics with a waiting message keep their order though. Erasing from a deque moves its elements, so the waiting
+  // messages are tracked by index, which doesn't change for the ones in front of an erased message.
+  std::vector<size_t> blocked;
+  size_t i = 0;
+  while (i < this->publish_queue_.size()) {
+    const MQTTMessage &message = this->publish_queue_[i].message;
+    bool wait = message.qos > 0 && this->free_inflight_slot_() == nullptr;
+    for (size_t j = 0; !wait && j < blocked.size(); j++)
+      wait = this->publish_queue_[blocked[j]].message.topic == message.topic;
+    if (wait) {
+      blocked.push_back(i++);
+      continue;
+    }
+    // the MQTT client's buffer is full, nothing else fits either
+    if (!this->send_message_(message.topic.c_str(), message.payload.data(), message.payload.size(), message.qos,
+                             message.retain))
+      break;
+
+    ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d)", message.topic.c_str(), message.payload.c_str(),
+             message.retain);
+    this->publish_queue_.erase(this->publish_queue_.begin() + i);
+  }
+}
+std::atomic<uint16_t> *MQTTClientComponent::free_inflight_slot_() {
+  for (uint8_t i = 0; i < this->max_inflight_; i++) {
+    if (this->inflight_ids_[i] == 0)
+      return &this->inflight_ids_[i];
+  }
+  return nullptr;
+}
+bool MQTTClientComponent::release_inflight_slot_(uint16_t packet_id) {
+  for (uint8_t i = 0; i < this->max_inflight_; i++) {
+    uint16_t expected = packet_id;
+    if (this->inflight_ids_[i].compare_exchange_strong(expected, 0))
+      return true;
+  }
+  return false;
+}
+void MQTTClientComponent::report_publish_dropped_() {
+  const uint32_t now = millis();
+  if (this->publish_dropped_ == this->publish_dropped_reported_ || now - this->publish_dropped_report_time_ < 10000)
+    return;
+
+  ESP_LOGW(TAG, "Publish queue full, dropped %u messages (%u in total)",  // NOLINT
+           this->publish_dropped_ - this->publish_dropped_reported_, this->publish_dropped_);
+  this->publish_dropped_reported_ = this->publish_dropped_;
+  this->publish_dropped_report_time_ = now;
 }
 
 bool MQTTClientComponent::publish(const MQTTMessage &message) {
@@ -510,6 +660,30 @@ void MQTTClientComponent::disable_shutdown_message() {
   this->recalculate_availability_();
 }
 bool MQTTClientComponent::is_discovery_enabled() const { return !this->discovery_info_.prefix.empty(); }
+uint32_t MQTTClientComponent::get_discovery_hash(uint16_t index) {
+  if (this->discovery_hashes_.empty()) {
+    // loaded on first use, when all MQTT components have been created
+    const uint16_t slots = MQTTComponent::get_discovery_hash_slots();
+    this->discovery_hashes_.resize(slots, 0);
+    // the type depends on the number of slots, so a table stored by a firmware with other components isn't loaded
+    this->discovery_hash_pref_ = global_preferences.make_preference(slots, fnv1_hash("mqtt_discovery") ^ slots);
+    if (!this->discovery_hash_pref_.is_initialized()) {
+      ESP_LOGW(TAG, "No room to store %u discovery hashes, discovery is sent again after every boot", slots);
+    } else {
+      // leaves the hashes at 0 if nothing was stored yet
+      this->discovery_hash_pref_.load(this->discovery_hashes_.data(), slots);
+    }
+  }
+  if (index >= this->discovery_hashes_.size())
+    return 0;
+  return this->discovery_hashes_[index];
+}
+void MQTTClientComponent::set_discovery_hash(uint16_t index, uint32_t hash) {
+  if (this->get_discovery_hash(index) == hash || index >= this->discovery_hashes_.size())
+    return;
+  this->discovery_hashes_[index] = hash;
+  this->discovery_hash_pref_.save(this->discovery_hashes_.data(), this->discovery_hashes_.size());
+}
 const Availability &MQTTClientComponent::get_availability() { return this->availability_; }
 void MQTTClientComponent::recalculate_availability_() {
   if (this->birth_message_.topic.empty() || this->birth_message_.topic != this->last_will_.topic) {
@@ -545,9 +719,13 @@ void MQTTClientComponent::disable_discovery() {
   this->discovery_info_ = MQTTDiscoveryInfo{.prefix = "", .retain = false};
 }
 void MQTTClientComponent::on_shutdown() {
+  this->process_publish_queue_();
   if (!this->shutdown_message_.topic.empty()) {
     yield();
-    this->publish(this->shutdown_message_);
+    // bypasses the inflight window, which may still be full with messages that are never acknowledged now
+    const MQTTMessage &message = this->shutdown_message_;
+    this->mqtt_client_.publish(message.topic.c_str(), message.qos, message.retain, message.payload.data(),
+                               message.payload.size());
     yield();
   }
   this->mqtt_client_.disconnect(true);
@@ -4,9 +4,13 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
 #include "esphome/components/json/json_util.h"
 #include <AsyncMqttClient.h>
 #include "lwip/ip_addr.h"
+#include <atomic>
+#include <deque>
+#include <memory>
 
 namespace esphome {
 namespace mqtt {
@@ -26,6 +30,13 @@ struct MQTTMessage {
   bool retain;
 };
 
+/// internal struct for messages waiting in the publish queue.
+struct MQTTQueuedMessage {
+  MQTTMessage message;
+  /// Whether this is the state of a component, a newer state for the same topic, QoS and retain flag replaces it.
+  bool state;
+};
+
 /// internal struct for MQTT subscriptions.
 struct MQTTSubscription {
   std::string topic;
@@ -68,6 +79,14 @@ enum MQTTClientState {
   MQTT_CLIENT_CONNECTED,
 };
 
+/// Whether the broker still has the retained messages of this node, checked after every connect.
+enum MQTTRetainedState {
+  MQTT_RETAINED_UNKNOWN = 0,  ///< Can't be checked, because the availability topic isn't retained.
+  MQTT_RETAINED_CHECKING,     ///< Waiting for the retained message on the availability topic.
+  MQTT_RETAINED_INTACT,
+  MQTT_RETAINED_LOST,
+};
+
 class MQTTComponent;
 
 class MQTTClientComponent : public Component {
@@ -102,6 +121,14 @@ class MQTTClientComponent : public Component {
   /// Globally disable Home Assistant discovery.
   void disable_discovery();
   bool is_discovery_enabled() const;
+  /// Whether the check for retained messages after connecting is still running, discovery should wait for it.
+  bool is_checking_retained_state() const { return this->retained_state_ == MQTT_RETAINED_CHECKING; }
+  /// Whether the broker kept the retained messages, so unchanged discovery messages don't have to be sent again.
+  bool is_retained_state_intact() const { return this->retained_state_ == MQTT_RETAINED_INTACT; }
+  /// Hash of the last retained discovery message of the MQTT component with the given slot, 0 if unknown.
+  uint32_t get_discovery_hash(uint16_t index);
+  /// Store the hash of the discovery message of an MQTT component, to skip it after a reconnect or reboot.
+  void set_discovery_hash(uint16_t index, uint32_t hash);
 
 #if ASYNC_TCP_SSL_ENABLED
   /** Add a SSL fingerprint to use for TCP SSL connections to the MQTT broker.
@@ -193,6 +220,29 @@ class MQTTClientComponent : public Component {
    */
   bool publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos = 0, bool retain = false);
 
+  /** Publish the state of a component.
+   *
+   * Only the latest state is relevant, so unlike with publish() a state that's still waiting in the publish queue
+   * is replaced by a newer one for the same topic, QoS and retain flag.
+   */
+  bool publish_state(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos, bool retain);
+
+  /** Set how many messages are buffered when the MQTT client can't send them right away.
+   *
+   * When the queue is full, publish() fails and components retry on their own.
+   */
+  void set_publish_queue_size(uint16_t publish_queue_size) { this->publish_queue_size_ = publish_queue_size; }
+  /// Set how many QoS 1 and 2 messages may be sent without being acknowledged by the broker yet.
+  void set_max_inflight(uint8_t max_inflight) { this->max_inflight_ = max_inflight; }
+  /// Whether there's room in the publish queue for another component's messages, used to pace discovery.
+  bool has_publish_capacity() const { return this->publish_queue_.size() * 2 < this->publish_queue_size_; }
+  /// Number of messages waiting in the publish queue.
+  size_t get_publish_queue_depth() const { return this->publish_queue_.size(); }
+  /// Highest number of messages that were waiting in the publish queue at the same time.
+  size_t get_publish_queue_max_depth() const { return this->publish_queue_max_depth_; }
+  /// Number of messages that were dropped because the publish queue was full.
+  uint32_t get_publish_dropped() const { return this->publish_dropped_; }
+
   /// Setup the MQTT client, registering a bunch of callbacks and attempting to connect.
   void setup() override;
   void dump_config() override;
@@ -236,6 +286,18 @@ class MQTTClientComponent : public Component {
   void recalculate_availability_();
 
   bool subscribe_(const char *topic, uint8_t qos);
+  bool publish_(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos, bool retain,
+                bool state);
+  /// Hand a message to the MQTT client, returns false if its buffer or the inflight window is full.
+  bool send_message_(const char *topic, const char *payload, size_t payload_length, uint8_t qos, bool retain);
+  /// Send queued messages in order until the MQTT client doesn't accept any more.
+  void process_publish_queue_();
+  /// A free slot for the packet id of a QoS 1 or 2 message, nullptr if the inflight window is full.
+  std::atomic<uint16_t> *free_inflight_slot_();
+  /// Free the slot of an acknowledged packet id, returns false if no slot holds it. Thread-safe.
+  bool release_inflight_slot_(uint16_t packet_id);
+  /// Log how many messages were dropped because the publish queue was full.
+  void report_publish_dropped_();
   void resubscribe_subscription_(MQTTSubscription *sub);
   void resubscribe_subscriptions_();
 
@@ -247,6 +309,15 @@ class MQTTClientComponent : public Component {
   /// See last_will_ for what different values denote.
   MQTTMessage birth_message_;
   bool sent_birth_message_{false};
+  MQTTRetainedState retained_state_{MQTT_RETAINED_UNKNOWN};
+  uint32_t retained_check_start_{0};
+  /** Hashes of the retained discovery messages, indexed by the slot of the MQTT component.
+   *
+   * All of them are kept in one preference, since one per component would use up the small preference storage of
+   * the ESP8266.
+   */
+  std::vector<uint32_t> discovery_hashes_;
+  ESPPreferenceObject discovery_hash_pref_;
   MQTTMessage shutdown_message_;
   /// Caches availability.
   Availability availability_{};
@@ -263,6 +334,21 @@ class MQTTClientComponent : public Component {
   int log_level_{ESPHOME_LOG_LEVEL};
 
   std::vector<MQTTSubscription> subscriptions_;
+  std::deque<MQTTQueuedMessage> publish_queue_;
+  uint16_t publish_queue_size_{32};
+  size_t publish_queue_max_depth_{0};
+  uint32_t publish_dropped_{0};
+  uint32_t publish_dropped_reported_{0};
+  uint32_t publish_dropped_report_time_{0};
+  uint8_t max_inflight_{4};
+  /** Packet ids of the sent QoS 1 and 2 messages that weren't acknowledged yet, 0 for free slots.
+   *
+   * Slots are only filled by the loop and only freed by the acknowledgement callback, which runs in the MQTT
+   * client's task on the ESP32, so they don't need a lock.
+   */
+  std::unique_ptr<std::atomic<uint16_t>[]> inflight_ids_;
+  /// An acknowledgement that arrived before its packet id was stored, which is possible since publish() returns it.
+  std::atomic<uint16_t> unmatched_ack_{0};
   AsyncMqttClient mqtt_client_;
   MQTTClientState state_{MQTT_CLIENT_DISCONNECTED};
   IPAddress ip_;
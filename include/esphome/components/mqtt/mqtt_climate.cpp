@@ -10,110 +10,116 @@ static const char *const TAG = "mqtt.climate";
 
 using namespace esphome::climate;
 
-void MQTTClimateComponent::send_discovery(JsonObject &root, mqtt::SendDiscoveryConfig &config) {
+void MQTTClimateComponent::send_discovery(json::JsonWriter &root, mqtt::SendDiscoveryConfig &config) {
   auto traits = this->device_->get_traits();
   // current_temperature_topic
   if (traits.get_supports_current_temperature()) {
     // current_temperature_topic
-    root["curr_temp_t"] = this->get_current_temperature_state_topic();
+    root.member("curr_temp_t", this->get_current_temperature_state_topic());
   }
   // mode_command_topic
-  root["mode_cmd_t"] = this->get_mode_command_topic();
+  root.member("mode_cmd_t", this->get_mode_command_topic());
   // mode_state_topic
-  root["mode_stat_t"] = this->get_mode_state_topic();
+  root.member("mode_stat_t", this->get_mode_state_topic());
   // modes
-  JsonArray &modes = root.createNestedArray("modes");
+  root.key("modes");
+  root.begin_array();
   // sort array for nice UI in HA
   if (traits.supports_mode(CLIMATE_MODE_AUTO))
-    modes.add("auto");
-  modes.add("off");
+    root.value("auto");
+  root.value("off");
   if (traits.supports_mode(CLIMATE_MODE_COOL))
-    modes.add("cool");
+    root.value("cool");
   if (traits.supports_mode(CLIMATE_MODE_HEAT))
-    modes.add("heat");
+    root.value("heat");
   if (traits.supports_mode(CLIMATE_MODE_FAN_ONLY))
-    modes.add("fan_only");
+    root.value("fan_only");
   if (traits.supports_mode(CLIMATE_MODE_DRY))
-    modes.add("dry");
+    root.value("dry");
   if (traits.supports_mode(CLIMATE_MODE_HEAT_COOL))
-    modes.add("heat_cool");
+    root.value("heat_cool");
+  root.end_array();
 
   if (traits.get_supports_two_point_target_temperature()) {
     // temperature_low_command_topic
-    root["temp_lo_cmd_t"] = this->get_target_temperature_low_command_topic();
+    root.member("temp_lo_cmd_t", this->get_target_temperature_low_command_topic());
     // temperature_low_state_topic
-    root["temp_lo_stat_t"] = this->get_target_temperature_low_state_topic();
+    root.member("temp_lo_stat_t", this->get_target_temperature_low_state_topic());
     // temperature_high_command_topic
-    root["temp_hi_cmd_t"] = this->get_target_temperature_high_command_topic();
+    root.member("temp_hi_cmd_t", this->get_target_temperature_high_command_topic());
     // temperature_high_state_topic
-    root["temp_hi_stat_t"] = this->get_target_temperature_high_state_topic();
+    root.member("temp_hi_stat_t", this->get_target_temperature_high_state_topic());
   } else {
     // temperature_command_topic
-    root["temp_cmd_t"] = this->get_target_temperature_command_topic();
+    root.member("temp_cmd_t", this->get_target_temperature_command_topic());
     // temperature_state_topic
-    root["temp_stat_t"] = this->get_target_temperature_state_topic();
+    root.member("temp_stat_t", this->get_target_temperature_state_topic());
   }
 
   // min_temp
-  root["min_temp"] = traits.get_visual_min_temperature();
+  root.member("min_temp", traits.get_visual_min_temperature());
   // max_temp
-  root["max_temp"] = traits.get_visual_max_temperature();
+  root.member("max_temp", traits.get_visual_max_temperature());
   // temp_step
-  root["temp_step"] = traits.get_visual_temperature_step();
+  root.member("temp_step", traits.get_visual_temperature_step());
 
   if (traits.get_supports_away()) {
     // away_mode_command_topic
-    root["away_mode_cmd_t"] = this->get_away_command_topic();
+    root.member("away_mode_cmd_t", this->get_away_command_topic());
     // away_mode_state_topic
-    root["away_mode_stat_t"] = this->get_away_state_topic();
+    root.member("away_mode_stat_t", this->get_away_state_topic());
   }
   if (traits.get_supports_action()) {
     // action_topic
-    root["act_t"] = this->get_action_state_topic();
+    root.member("act_t", this->get_action_state_topic());
   }
 
   if (traits.get_supports_fan_modes()) {
     // fan_mode_command_topic
-    root["fan_mode_cmd_t"] = this->get_fan_mode_command_topic();
+    root.member("fan_mode_cmd_t", this->get_fan_mode_command_topic());
     // fan_mode_state_topic
-    root["fan_mode_stat_t"] = this->get_fan_mode_state_topic();
+    root.member("fan_mode_stat_t", this->get_fan_mode_state_topic());
     // fan_modes
-    JsonArray &fan_modes = root.createNestedArray("fan_modes");
+    root.key("fan_modes");
+    root.begin_array();
     if (traits.supports_fan_mode(CLIMATE_FAN_ON))
-      fan_modes.add("on");
+      root.value("on");
     if (traits.supports_fan_mode(CLIMATE_FAN_OFF))
-      fan_modes.add("off");
+      root.value("off");
     if (traits.supports_fan_mode(CLIMATE_FAN_AUTO))
-      fan_modes.add("auto");
+      root.value("auto");
     if (traits.supports_fan_mode(CLIMATE_FAN_LOW))
-      fan_modes.add("low");
+      root.value("low");
     if (traits.supports_fan_mode(CLIMATE_FAN_MEDIUM))
-      fan_modes.add("medium");
+      root.value("medium");
     if (traits.supports_fan_mode(CLIMATE_FAN_HIGH))
-      fan_modes.add("high");
+      root.value("high");
     if (traits.supports_fan_mode(CLIMATE_FAN_MIDDLE))
-      fan_modes.add("middle");
+      root.value("middle");
     if (traits.supports_fan_mode(CLIMATE_FAN_FOCUS))
-      fan_modes.add("focus");
+      root.value("focus");
     if (traits.supports_fan_mode(CLIMATE_FAN_DIFFUSE))
-      fan_modes.add("diffuse");
+      root.value("diffuse");
+    root.end_array();
   }
 
   if (traits.get_supports_swing_modes()) {
     // swing_mode_command_topic
-    root["swing_mode_cmd_t"] = this->get_swing_mode_command_topic();
+    root.member("swing_mode_cmd_t", this->get_swing_mode_command_topic());
     // swing_mode_state_topic
-    root["swing_mode_stat_t"] = this->get_swing_mode_state_topic();
+    root.member("swing_mode_stat_t", this->get_swing_mode_state_topic());
     // swing_modes
-    JsonArray &swing_modes = root.createNestedArray("swing_modes");
+    root.key("swing_modes");
+    root.begin_array();
     if (traits.supports_swing_mode(CLIMATE_SWING_OFF))
-      swing_modes.add("off");
+      root.value("off");
     if (traits.supports_swing_mode(CLIMATE_SWING_BOTH))
-      swing_modes.add("both");
+      root.value("both");
     if (traits.supports_swing_mode(CLIMATE_SWING_VERTICAL))
-      swing_modes.add("vertical");
+      root.value("vertical");
     if (traits.supports_swing_mode(CLIMATE_SWING_HORIZONTAL))
-      swing_modes.add("horizontal");
+      root.value("horizontal");
+    root.end_array();
   }
 
   config.state_topic = false;
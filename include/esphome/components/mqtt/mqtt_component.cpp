@@ -37,13 +37,15 @@ const std::string MQTTComponent::get_command_topic_() const {
 bool MQTTComponent::publish(const std::string &topic, const std::string &payload) {
   if (topic.empty())
     return false;
-  return global_mqtt_client->publish(topic, payload, 0, this->retain_);
+  return global_mqtt_client->publish_state(topic, payload.data(), payload.size(), 0, this->retain_);
 }
 
 bool MQTTComponent::publish_json(const std::string &topic, const json::json_build_t &f) {
   if (topic.empty())
     return false;
-  return global_mqtt_client->publish_json(topic, f, 0, this->retain_);
+  size_t len;
+  const char *message = json::build_json(f, &len);
+  return global_mqtt_client->publish_state(topic, message, len, 0, this->retain_);
 }
 
 bool MQTTComponent::send_discovery_() {
@@ -51,63 +53,88 @@ bool MQTTComponent::send_discovery_() {
 
   if (discovery_info.clean) {
     ESP_LOGV(TAG, "'%s': Cleaning discovery...", this->friendly_name().c_str());
-    return global_mqtt_client->publish(this->get_discovery_topic_(discovery_info), "", 0, 0, true);
+    if (!global_mqtt_client->publish(this->get_discovery_topic_(discovery_info), "", 0, 0, true))
+      return false;
+    global_mqtt_client->set_discovery_hash(this->discovery_hash_index_, 0);
+    return true;
   }
 
   ESP_LOGV(TAG, "'%s': Sending discovery...", this->friendly_name().c_str());
 
-  return global_mqtt_client->publish_json(
-      this->get_discovery_topic_(discovery_info),
-      [this](JsonObject &root) {
+  size_t length;
+  const char *payload = json::write_json(
+      [this](json::JsonWriter &root) {
         SendDiscoveryConfig config;
         config.state_topic = true;
         config.command_topic = true;
 
+        root.begin_object();
         this->send_discovery(root, config);
 
         std::string name = this->friendly_name();
-        root["name"] = name;
+        root.member("name", name);
         if (config.state_topic)
-          root["state_topic"] = this->get_state_topic_();
+          root.member("state_topic", this->get_state_topic_());
         if (config.command_topic)
-          root["command_topic"] = this->get_command_topic_();
+          root.member("command_topic", this->get_command_topic_());
 
         if (this->availability_ == nullptr) {
           if (!global_mqtt_client->get_availability().topic.empty()) {
-            root["availability_topic"] = global_mqtt_client->get_availability().topic;
+            root.member("availability_topic", global_mqtt_client->get_availability().topic);
             if (global_mqtt_client->get_availability().payload_available != "online")
-              root["payload_available"] = global_mqtt_client->get_availability().payload_available;
+              root.member("payload_available", global_mqtt_client->get_availability().payload_available);
             if (global_mqtt_client->get_availability().payload_not_available != "offline")
-              root["payload_not_available"] = global_mqtt_client->get_availability().payload_not_available;
+              root.member("payload_not_available", global_mqtt_client->get_availability().payload_not_available);
           }
         } else if (!this->availability_->topic.empty()) {
-          root["availability_topic"] = this->availability_->topic;
+          root.member("availability_topic", this->availability_->topic);
           if (this->availability_->payload_available != "online")
-            root["payload_available"] = this->availability_->payload_available;
+            root.member("payload_available", this->availability_->payload_available);
           if (this->availability_->payload_not_available != "offline")
-            root["payload_not_available"] = this->availability_->payload_not_available;
+            root.member("payload_not_available", this->availability_->payload_not_available);
         }
 
         const std::string &node_name = App.get_name();
         std::string unique_id = this->unique_id();
         if (!unique_id.empty()) {
-          root["unique_id"] = unique_id;
+          root.member("unique_id", unique_id);
         } else {
           // default to almost-unique ID. It's a hack but the only way to get that
           // gorgeous device registry view.
-          root["unique_id"] = "ESP" + this->component_type() + this->get_default_object_id_();
+          root.member("unique_id", "ESP" + this->component_type() + this->get_default_object_id_());
         }
 
-        JsonObject &device_info = root.createNestedObject("device");
-        device_info["identifiers"] = get_mac_address();
-        device_info["name"] = node_name;
-        device_info["sw_version"] = "esphome v" ESPHOME_VERSION " " + App.get_compilation_time();
+        root.key("device");
+        root.begin_object();
+        root.member("identifiers", get_mac_address());
+        root.member("name", node_name);
+        root.member("sw_version", "esphome v" ESPHOME_VERSION " " + App.get_compilation_time());
 #ifdef ARDUINO_BOARD
-        device_info["model"] = ARDUINO_BOARD;
+        root.member("model", ARDUINO_BOARD);
 #endif
-        device_info["manufacturer"] = "espressif";
+        root.member("manufacturer", "espressif");
+        root.end_object();
+        root.end_object();
       },
-      0, discovery_info.retain);
+      &length);
+
+  const std::string topic = this->get_discovery_topic_(discovery_info);
+  uint32_t hash = fnv1_hash(topic);
+  for (size_t i = 0; i < length; i++) {
+    hash *= 16777619UL;
+    hash ^= payload[i];
+  }
+  if (discovery_info.retain && hash == global_mqtt_client->get_discovery_hash(this->discovery_hash_index_) &&
+      global_mqtt_client->is_retained_state_intact()) {
+    ESP_LOGV(TAG, "'%s': Discovery unchanged, the broker still has it.", this->friendly_name().c_str());
+    return true;
+  }
+
+  if (!global_mqtt_client->publish(topic, payload, length, 0, discovery_info.retain))
+    return false;
+  if (discovery_info.retain)
+    global_mqtt_client->set_discovery_hash(this->discovery_hash_index_, hash);
+  return true;
 }
 
 bool MQTTComponent::get_retain() const { return this->retain_; }
@@ -128,7 +155,12 @@ void MQTTComponent::subscribe_json(const std::string &topic, const mqtt_json_cal
   global_mqtt_client->subscribe_json(topic, callback, qos);
 }
 
-MQTTComponent::MQTTComponent() = default;
+/// Number of MQTT components, each has a slot in the discovery hash table of the MQTT client. They're assigned in the
+/// order the components are created, which is the same on every boot.
+static uint16_t discovery_hash_slots = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+MQTTComponent::MQTTComponent() : discovery_hash_index_(discovery_hash_slots++) {}
+uint16_t MQTTComponent::get_discovery_hash_slots() { return discovery_hash_slots; }
 
 float MQTTComponent::get_setup_priority() const { return setup_priority::AFTER_CONNECTION; }
 void MQTTComponent::disable_discovery() { this->discovery_enabled_ = false; }
@@ -159,6 +191,13 @@ void MQTTComponent::call_setup() {
   if (!this->is_connected_())
     return;
 
+  if (!global_mqtt_client->has_publish_capacity() || global_mqtt_client->is_checking_retained_state()) {
+    // send discovery and state later, when the messages of the components before this one are out and it's known
+    // whether the broker still has the retained discovery messages
+    this->schedule_resend_state();
+    return;
+  }
+
   if (this->is_discovery_enabled()) {
     if (!this->send_discovery_()) {
       this->schedule_resend_state();
@@ -179,6 +218,12 @@ void MQTTComponent::call_loop() {
     return;
   }
 
+  // after boot or a reconnect all components resend at once, pace them so the publish queue doesn't overflow, and
+  // wait until it's known whether unchanged discovery messages can be skipped
+  if (!global_mqtt_client->has_publish_capacity() || global_mqtt_client->is_checking_retained_state()) {
+    return;
+  }
+
   this->resend_state_ = false;
   if (this->is_discovery_enabled()) {
     if (!this->send_discovery_()) {
@@ -55,13 +55,16 @@ class MQTTComponent : public Component {
   /// Constructs a MQTTComponent.
   explicit MQTTComponent();
 
+  /// Number of slots the discovery hash table of the MQTT client needs, one for every MQTT component.
+  static uint16_t get_discovery_hash_slots();
+
   /// Override setup_ so that we can call send_discovery() when needed.
   void call_setup() override;
 
   void call_loop() override;
 
   /// Send discovery info the Home Assistant, override this.
-  virtual void send_discovery(JsonObject &root, SendDiscoveryConfig &config) = 0;
+  virtual void send_discovery(json::JsonWriter &root, SendDiscoveryConfig &config) = 0;
 
   virtual bool send_initial_state() = 0;
 
@@ -96,14 +99,14 @@ class MQTTComponent : public Component {
   /// Internal method for the MQTT client base to schedule a resend of the state on reconnect.
   void schedule_resend_state();
 
-  /** Send a MQTT message.
+  /** Send a MQTT message with the state of this component, replacing an older state that's still queued.
    *
    * @param topic The topic.
    * @param payload The payload.
    */
   bool publish(const std::string &topic, const std::string &payload);
 
-  /** Construct and send a JSON MQTT message.
+  /** Construct and send a JSON MQTT message with the state of this component.
    *
    * @param topic The topic.
    * @param f The Json Message builder.
@@ -173,6 +176,8 @@ class MQTTComponent : public Component {
   bool discovery_enabled_{true};
   Availability *availability_{nullptr};
   bool resend_state_{false};
+  /// Slot of this component in the discovery hash table of the MQTT client.
+  uint16_t discovery_hash_index_;
 };
 
 }  // namespace mqtt
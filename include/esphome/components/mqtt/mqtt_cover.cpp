@@ -60,18 +60,18 @@ void MQTTCoverComponent::dump_config() {
     ESP_LOGCONFIG(TAG, "  Tilt Command Topic: '%s'", this->get_tilt_command_topic().c_str());
   }
 }
-void MQTTCoverComponent::send_discovery(JsonObject &root, mqtt::SendDiscoveryConfig &config) {
+void MQTTCoverComponent::send_discovery(json::JsonWriter &root, mqtt::SendDiscoveryConfig &config) {
   auto traits = this->cover_->get_traits();
   if (traits.get_is_assumed_state()) {
-    root["optimistic"] = true;
+    root.member("optimistic", true);
   }
   if (traits.get_supports_position()) {
-    root["position_topic"] = this->get_position_state_topic();
-    root["set_position_topic"] = this->get_position_command_topic();
+    root.member("position_topic", this->get_position_state_topic());
+    root.member("set_position_topic", this->get_position_command_topic());
   }
   if (traits.get_supports_tilt()) {
-    root["tilt_status_topic"] = this->get_tilt_state_topic();
-    root["tilt_command_topic"] = this->get_tilt_command_topic();
+    root.member("tilt_status_topic", this->get_tilt_state_topic());
+    root.member("tilt_command_topic", this->get_tilt_command_topic());
   }
   if (traits.get_supports_tilt() && !traits.get_supports_position()) {
     config.command_topic = false;
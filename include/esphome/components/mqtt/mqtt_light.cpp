@@ -13,8 +13,15 @@ using namespace esphome::light;
 std::string MQTTJSONLightComponent::component_type() const { return "light"; }
 
 void MQTTJSONLightComponent::setup() {
-  this->subscribe_json(this->get_command_topic_(), [this](const std::string &topic, JsonObject &root) {
-    this->state_->make_call().parse_json(root).perform();
+  this->subscribe(this->get_command_topic_(), [this](const std::string &topic, const std::string &payload) {
+    json::JsonReader reader(payload);
+    auto call = this->state_->make_call();
+    call.parse_json(reader);
+    if (reader.has_error()) {
+      ESP_LOGW(TAG, "Parsing JSON failed.");
+      return;
+    }
+    call.perform();
   });
 
   auto f = std::bind(&MQTTJSONLightComponent::publish_state_, this);
@@ -28,23 +35,25 @@ bool MQTTJSONLightComponent::publish_state_() {
 }
 LightState *MQTTJSONLightComponent::get_state() const { return this->state_; }
 std::string MQTTJSONLightComponent::friendly_name() const { return this->state_->get_name(); }
-void MQTTJSONLightComponent::send_discovery(JsonObject &root, mqtt::SendDiscoveryConfig &config) {
-  root["schema"] = "json";
+void MQTTJSONLightComponent::send_discovery(json::JsonWriter &root, mqtt::SendDiscoveryConfig &config) {
+  root.member("schema", "json");
   auto traits = this->state_->get_traits();
   if (traits.get_supports_brightness())
-    root["brightness"] = true;
+    root.member("brightness", true);
   if (traits.get_supports_rgb())
-    root["rgb"] = true;
+    root.member("rgb", true);
   if (traits.get_supports_color_temperature())
-    root["color_temp"] = true;
+    root.member("color_temp", true);
   if (traits.get_supports_rgb_white_value())
-    root["white_value"] = true;
+    root.member("white_value", true);
   if (this->state_->supports_effects()) {
-    root["effect"] = true;
-    JsonArray &effect_list = root.createNestedArray("effect_list");
+    root.member("effect", true);
+    root.key("effect_list");
+    root.begin_array();
     for (auto *effect : this->state_->get_effects())
-      effect_list.add(effect->get_name());
-    effect_list.add("None");
+      root.value(effect->get_name());
+    root.value("None");
+    root.end_array();
   }
 }
 bool MQTTJSONLightComponent::send_initial_state() { return this->publish_state_(); }
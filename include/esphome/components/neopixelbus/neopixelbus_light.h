@@ -105,6 +105,13 @@ class NeoPixelBusLightOutputBase : public light::AddressableLight {
   }
 
  protected:
+  void describe_raw_pixels_(light::ESPRawPixels *raw, uint8_t stride) const {
+    raw->data = this->controller_->Pixels();
+    raw->stride = stride;
+    memcpy(raw->offsets, this->rgb_offsets_, sizeof(raw->offsets));
+    raw->effect_data = this->effect_data_;
+  }
+
   NeoPixelBus<T_COLOR_FEATURE, T_METHOD> *controller_{nullptr};
   uint8_t *effect_data_{nullptr};
   uint8_t rgb_offsets_[4]{0, 1, 2, 3};
@@ -126,6 +133,10 @@ class NeoPixelRGBLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_COL
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                nullptr, this->effect_data_ + index, &this->correction_);
   }
+  bool get_raw_pixels_internal(light::ESPRawPixels *raw) const override {
+    this->describe_raw_pixels_(raw, 3);
+    return true;
+  }
 };
 
 template<typename T_METHOD, typename T_COLOR_FEATURE = NeoRgbwFeature>
@@ -145,6 +156,10 @@ class NeoPixelRGBWLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_CO
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                base + this->rgb_offsets_[3], this->effect_data_ + index, &this->correction_);
   }
+  bool get_raw_pixels_internal(light::ESPRawPixels *raw) const override {
+    this->describe_raw_pixels_(raw, 4);
+    return true;
+  }
 };
 
 }  // namespace neopixelbus
@@ -47,6 +47,10 @@ void OTAComponent::loop() {
     this->clean_rtc();
   }
 }
+bool OTAComponent::can_loop_tickless() const {
+  // Accepting a new OTA connection up to a second later is fine, the transfer itself blocks in loop()
+  return true;
+}
 
 void OTAComponent::handle_() {
   OTAResponseTypes error_code = OTA_RESPONSE_ERROR_UNKNOWN;
@@ -55,6 +55,7 @@ class OTAComponent : public Component {
   void dump_config() override;
   float get_setup_priority() const override;
   void loop() override;
+  bool can_loop_tickless() const override;
 
   uint16_t get_port() const;
 
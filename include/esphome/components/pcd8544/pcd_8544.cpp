@@ -112,11 +112,11 @@ void PCD8544::command(uint8_t value) {
 }
 
 void PCD8544::update() {
-  this->do_update_();
-  this->display();
+  if (this->do_update_())
+    this->display();
 }
 
-void PCD8544::fill(Color color) {
+void PCD8544::fill_buffer_internal(Color color) {
   uint8_t fill = color.is_on() ? 0xFF : 0x00;
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
     this->buffer_[i] = fill;
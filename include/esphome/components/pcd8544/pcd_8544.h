@@ -45,7 +45,7 @@ class PCD8544 : public PollingComponent,
 
   void update() override;
 
-  void fill(Color color) override;
+  void fill_buffer_internal(Color color) override;
 
   void setup() override {
     this->setup_pins_();
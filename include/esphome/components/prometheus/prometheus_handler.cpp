@@ -1,310 +1,535 @@
 #include "prometheus_handler.h"
 #include "esphome/core/application.h"
+#include "esphome/core/defines.h"
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+#ifdef USE_WIFI
+#include "esphome/components/wifi/wifi_component.h"
+#endif
+#ifdef USE_API
+#include "esphome/components/api/api_server.h"
+#endif
+#ifdef USE_MQTT
+#include "esphome/components/mqtt/mqtt_client.h"
+#endif
 
 namespace esphome {
 namespace prometheus {
 
-void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
-  AsyncResponseStream *stream = req->beginResponseStream("text/plain");
+enum PrometheusSection : uint8_t {
+  SECTION_RUNTIME = 0,
+  SECTION_SENSOR,
+  SECTION_BINARY_SENSOR,
+  SECTION_FAN,
+  SECTION_LIGHT,
+  SECTION_COVER,
+  SECTION_SWITCH,
+  SECTION_COMPONENT,
+  SECTION_DONE,
+};
+
+/// Append a label value, with backslashes, quotes and newlines escaped as the text format requires.
+static void append_escaped(std::string *out, const std::string &value) {
+  for (char c : value) {
+    if (c == '\\' || c == '"') {
+      out->push_back('\\');
+      out->push_back(c);
+    } else if (c == '\n') {
+      out->append("\\n");
+    } else {
+      out->push_back(c);
+    }
+  }
+}
+static void append_uint(std::string *out, uint32_t value) {
+  char buffer[10];
+  char *pos = buffer + sizeof(buffer);
+  do {
+    *--pos = char('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  out->append(pos, buffer + sizeof(buffer) - pos);
+}
+static void append_int(std::string *out, int32_t value) {
+  if (value < 0) {
+    out->push_back('-');
+    append_uint(out, -uint32_t(value));
+  } else {
+    append_uint(out, value);
+  }
+}
+/// Append a number with the given number of decimals, without going through printf for the common cases.
+static void append_float(std::string *out, float value, int8_t accuracy_decimals) {
+  static const float POW10[] = {1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f, 100000.0f, 1000000.0f};
+  if (std::isnan(value)) {
+    out->append("NaN");
+    return;
+  }
+  if (accuracy_decimals < 0 || accuracy_decimals > 6) {
+    out->append(value_accuracy_to_string(value, accuracy_decimals));
+    return;
+  }
+  // rounded like value_accuracy_to_string(), so the value is the same as in the other integrations
+  const float rounded = roundf(value * POW10[accuracy_decimals]);
+  // beyond 2^23 the float value_accuracy_to_string() prints doesn't have to have the digits of rounded
+  if (!(std::fabs(rounded) < 8388608.0f)) {
+    out->append(value_accuracy_to_string(value, accuracy_decimals));
+    return;
+  }
 
+  auto digits = uint32_t(std::fabs(rounded));
+  char buffer[16];
+  char *pos = buffer + sizeof(buffer);
+  for (int8_t i = 0; i < accuracy_decimals; i++) {
+    *--pos = char('0' + digits % 10);
+    digits /= 10;
+  }
+  if (accuracy_decimals > 0)
+    *--pos = '.';
+  do {
+    *--pos = char('0' + digits % 10);
+    digits /= 10;
+  } while (digits != 0);
+  if (std::signbit(rounded))
+    *--pos = '-';
+  out->append(pos, buffer + sizeof(buffer) - pos);
+}
+
+void PrometheusHandler::setup() {
 #ifdef USE_SENSOR
-  this->sensor_type_(stream);
   for (auto *obj : App.get_sensors())
-    this->sensor_row_(stream, obj);
+    this->add_labels_(obj);
 #endif
-
 #ifdef USE_BINARY_SENSOR
-  this->binary_sensor_type_(stream);
   for (auto *obj : App.get_binary_sensors())
-    this->binary_sensor_row_(stream, obj);
+    this->add_labels_(obj);
 #endif
-
 #ifdef USE_FAN
-  this->fan_type_(stream);
   for (auto *obj : App.get_fans())
-    this->fan_row_(stream, obj);
+    this->add_labels_(obj);
 #endif
-
 #ifdef USE_LIGHT
-  this->light_type_(stream);
   for (auto *obj : App.get_lights())
-    this->light_row_(stream, obj);
+    this->add_labels_(obj);
 #endif
-
 #ifdef USE_COVER
-  this->cover_type_(stream);
   for (auto *obj : App.get_covers())
-    this->cover_row_(stream, obj);
+    this->add_labels_(obj);
 #endif
-
 #ifdef USE_SWITCH
-  this->switch_type_(stream);
   for (auto *obj : App.get_switches())
-    this->switch_row_(stream, obj);
+    this->add_labels_(obj);
+#endif
+
+  this->base_->init();
+  this->base_->add_handler(this);
+}
+
+void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
+  // Each request has its own position, several scrapes can run at the same time
+  auto response = std::make_shared<PrometheusResponse>();
+  req->send(req->beginChunkedResponse("text/plain", [this, response](uint8_t *buffer, size_t max_len, size_t index) {
+    return this->fill_(response.get(), buffer, max_len);
+  }));
+}
+size_t PrometheusHandler::fill_(PrometheusResponse *response, uint8_t *buffer, size_t max_len) {
+  size_t written = 0;
+  while (written < max_len) {
+    if (response->offset == response->pending.size()) {
+      response->pending.clear();
+      response->offset = 0;
+      if (!this->render_next_(response))
+        break;
+      continue;
+    }
+    const size_t len = std::min(max_len - written, response->pending.size() - response->offset);
+    memcpy(buffer + written, response->pending.data() + response->offset, len);
+    written += len;
+    response->offset += len;
+  }
+  return written;
+}
+bool PrometheusHandler::render_next_(PrometheusResponse *response) {
+  while (true) {
+    bool rendered = false;
+    switch (response->section) {
+      case SECTION_RUNTIME:
+        if (response->index == 0) {
+          this->runtime_rows_(&response->pending);
+          rendered = true;
+        }
+        break;
+#ifdef USE_SENSOR
+      case SECTION_SENSOR:
+        rendered = this->render_section_(response, App.get_sensors(), &PrometheusHandler::sensor_type_,
+                                         &PrometheusHandler::sensor_row_);
+        break;
+#endif
+#ifdef USE_BINARY_SENSOR
+      case SECTION_BINARY_SENSOR:
+        rendered = this->render_section_(response, App.get_binary_sensors(), &PrometheusHandler::binary_sensor_type_,
+                                         &PrometheusHandler::binary_sensor_row_);
+        break;
+#endif
+#ifdef USE_FAN
+      case SECTION_FAN:
+        rendered =
+            this->render_section_(response, App.get_fans(), &PrometheusHandler::fan_type_, &PrometheusHandler::fan_row_);
+        break;
+#endif
+#ifdef USE_LIGHT
+      case SECTION_LIGHT:
+        rendered = this->render_section_(response, App.get_lights(), &PrometheusHandler::light_type_,
+                                         &PrometheusHandler::light_row_);
+        break;
+#endif
+#ifdef USE_COVER
+      case SECTION_COVER:
+        rendered = this->render_section_(response, App.get_covers(), &PrometheusHandler::cover_type_,
+                                         &PrometheusHandler::cover_row_);
+        break;
 #endif
+#ifdef USE_SWITCH
+      case SECTION_SWITCH:
+        rendered = this->render_section_(response, App.get_switches(), &PrometheusHandler::switch_type_,
+                                         &PrometheusHandler::switch_row_);
+        break;
+#endif
+#ifdef USE_COMPONENT_PROFILER
+      case SECTION_COMPONENT: {
+        const auto &objs = App.get_components();
+        if (response->index == 0) {
+          this->component_type_(&response->pending);
+          rendered = true;
+        } else if (response->index <= objs.size()) {
+          this->component_row_(&response->pending, objs[response->index - 1], response->index - 1);
+          rendered = true;
+        }
+        break;
+      }
+#endif
+      case SECTION_DONE:
+        return false;
+      default:
+        break;
+    }
+    if (rendered) {
+      response->index++;
+      return true;
+    }
+    response->section++;
+    response->index = 0;
+  }
+}
+template<typename T>
+bool PrometheusHandler::render_section_(PrometheusResponse *response, const std::vector<T *> &objs,
+                                        void (PrometheusHandler::*type)(std::string *out),
+                                        void (PrometheusHandler::*row)(std::string *out, T *obj)) {
+  if (response->index == 0) {
+    (this->*type)(&response->pending);
+  } else if (response->index <= objs.size()) {
+    (this->*row)(&response->pending, objs[response->index - 1]);
+  } else {
+    return false;
+  }
+  return true;
+}
 
-  req->send(stream);
+void PrometheusHandler::add_labels_(Nameable *obj) {
+  std::string labels = "id=\"";
+  append_escaped(&labels, obj->get_object_id());
+  labels += "\",name=\"";
+  append_escaped(&labels, obj->get_name());
+  labels += '"';
+  this->labels_[obj] = labels;
+}
+void PrometheusHandler::begin_row_(std::string *out, const char *metric, Nameable *obj) {
+  out->append(metric);
+  out->push_back('{');
+  auto it = this->labels_.find(obj);
+  if (it != this->labels_.end())
+    out->append(it->second);
+}
+
+void PrometheusHandler::runtime_rows_(std::string *out) {
+  out->append("#TYPE esphome_free_heap_bytes GAUGE\n");
+  out->append("esphome_free_heap_bytes ");
+  append_uint(out, ESP.getFreeHeap());
+  out->append("\n#TYPE esphome_loop_time_ms GAUGE\n");
+  out->append("esphome_loop_time_ms ");
+  append_uint(out, App.get_loop_duration());
+  out->push_back('\n');
+#ifdef USE_WIFI
+  if (wifi::global_wifi_component != nullptr && wifi::global_wifi_component->is_connected()) {
+    out->append("#TYPE esphome_wifi_rssi_dbm GAUGE\n");
+    out->append("esphome_wifi_rssi_dbm ");
+    append_int(out, WiFi.RSSI());
+    out->push_back('\n');
+  }
+#endif
+#ifdef USE_API
+  if (api::global_api_server != nullptr) {
+    out->append("#TYPE esphome_api_clients GAUGE\n");
+    out->append("esphome_api_clients ");
+    append_uint(out, api::global_api_server->get_client_count());
+    out->push_back('\n');
+  }
+#endif
+#ifdef USE_MQTT
+  if (mqtt::global_mqtt_client != nullptr) {
+    out->append("#TYPE esphome_mqtt_publish_queue_depth GAUGE\n");
+    out->append("esphome_mqtt_publish_queue_depth ");
+    append_uint(out, mqtt::global_mqtt_client->get_publish_queue_depth());
+    out->append("\n#TYPE esphome_mqtt_publish_queue_max_depth GAUGE\n");
+    out->append("esphome_mqtt_publish_queue_max_depth ");
+    append_uint(out, mqtt::global_mqtt_client->get_publish_queue_max_depth());
+    out->append("\n#TYPE esphome_mqtt_publish_dropped_total COUNTER\n");
+    out->append("esphome_mqtt_publish_dropped_total ");
+    append_uint(out, mqtt::global_mqtt_client->get_publish_dropped());
+    out->push_back('\n');
+  }
+#endif
 }
 
 // Type-specific implementation
 #ifdef USE_SENSOR
-void PrometheusHandler::sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_sensor_failed GAUGE\n"));
+void PrometheusHandler::sensor_type_(std::string *out) {
+  out->append("#TYPE esphome_sensor_value GAUGE\n");
+  out->append("#TYPE esphome_sensor_failed GAUGE\n");
 }
-void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj) {
+void PrometheusHandler::sensor_row_(std::string *out, sensor::Sensor *obj) {
   if (obj->is_internal())
     return;
   if (!isnan(obj->state)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
+    this->begin_row_(out, "esphome_sensor_failed", obj);
+    out->append("} 0\n");
     // Data itself
-    stream->print(F("esphome_sensor_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",unit=\""));
-    stream->print(obj->get_unit_of_measurement().c_str());
-    stream->print(F("\"} "));
-    stream->print(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
-    stream->print('\n');
+    this->begin_row_(out, "esphome_sensor_value", obj);
+    out->append(",unit=\"");
+    append_escaped(out, obj->get_unit_of_measurement());
+    out->append("\"} ");
+    append_float(out, obj->state, obj->get_accuracy_decimals());
+    out->push_back('\n');
   } else {
     // Invalid state
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    this->begin_row_(out, "esphome_sensor_failed", obj);
+    out->append("} 1\n");
   }
 }
 #endif
 
 // Type-specific implementation
 #ifdef USE_BINARY_SENSOR
-void PrometheusHandler::binary_sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_binary_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_binary_sensor_failed GAUGE\n"));
+void PrometheusHandler::binary_sensor_type_(std::string *out) {
+  out->append("#TYPE esphome_binary_sensor_value GAUGE\n");
+  out->append("#TYPE esphome_binary_sensor_failed GAUGE\n");
 }
-void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj) {
+void PrometheusHandler::binary_sensor_row_(std::string *out, binary_sensor::BinarySensor *obj) {
   if (obj->is_internal())
     return;
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
+    this->begin_row_(out, "esphome_binary_sensor_failed", obj);
+    out->append("} 0\n");
     // Data itself
-    stream->print(F("esphome_binary_sensor_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->state);
-    stream->print('\n');
+    this->begin_row_(out, "esphome_binary_sensor_value", obj);
+    out->append(obj->state ? "} 1\n" : "} 0\n");
   } else {
     // Invalid state
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    this->begin_row_(out, "esphome_binary_sensor_failed", obj);
+    out->append("} 1\n");
   }
 }
 #endif
 
 #ifdef USE_FAN
-void PrometheusHandler::fan_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_fan_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_failed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_speed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_oscillation GAUGE\n"));
+void PrometheusHandler::fan_type_(std::string *out) {
+  out->append("#TYPE esphome_fan_value GAUGE\n");
+  out->append("#TYPE esphome_fan_failed GAUGE\n");
+  out->append("#TYPE esphome_fan_speed GAUGE\n");
+  out->append("#TYPE esphome_fan_oscillation GAUGE\n");
 }
-void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::FanState *obj) {
+void PrometheusHandler::fan_row_(std::string *out, fan::FanState *obj) {
   if (obj->is_internal())
     return;
-  stream->print(F("esphome_fan_failed{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} 0\n"));
+  this->begin_row_(out, "esphome_fan_failed", obj);
+  out->append("} 0\n");
   // Data itself
-  stream->print(F("esphome_fan_value{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+  this->begin_row_(out, "esphome_fan_value", obj);
+  out->append(obj->state ? "} 1\n" : "} 0\n");
   // Speed if available
   if (obj->get_traits().supports_speed()) {
-    stream->print(F("esphome_fan_speed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->speed);
-    stream->print('\n');
+    this->begin_row_(out, "esphome_fan_speed", obj);
+    out->append("} ");
+    append_int(out, obj->speed);
+    out->push_back('\n');
   }
   // Oscillation if available
   if (obj->get_traits().supports_oscillation()) {
-    stream->print(F("esphome_fan_oscillation{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->oscillating);
-    stream->print('\n');
+    this->begin_row_(out, "esphome_fan_oscillation", obj);
+    out->append(obj->oscillating ? "} 1\n" : "} 0\n");
   }
 }
 #endif
 
 #ifdef USE_LIGHT
-void PrometheusHandler::light_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_light_state GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_color GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_effect_active GAUGE\n"));
+void PrometheusHandler::light_type_(std::string *out) {
+  out->append("#TYPE esphome_light_state GAUGE\n");
+  out->append("#TYPE esphome_light_color GAUGE\n");
+  out->append("#TYPE esphome_light_effect_active GAUGE\n");
 }
-void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj) {
+void PrometheusHandler::light_row_(std::string *out, light::LightState *obj) {
   if (obj->is_internal())
     return;
   // State
-  stream->print(F("esphome_light_state{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->remote_values.is_on());
-  stream->print(F("\n"));
+  this->begin_row_(out, "esphome_light_state", obj);
+  out->append(obj->remote_values.is_on() ? "} 1\n" : "} 0\n");
   // Brightness and RGBW
   light::LightColorValues color = obj->current_values;
   float brightness, r, g, b, w;
   color.as_brightness(&brightness);
   color.as_rgbw(&r, &g, &b, &w);
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"brightness\"} "));
-  stream->print(brightness);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"r\"} "));
-  stream->print(r);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"g\"} "));
-  stream->print(g);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"b\"} "));
-  stream->print(b);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"w\"} "));
-  stream->print(w);
-  stream->print(F("\n"));
+  this->begin_row_(out, "esphome_light_color", obj);
+  out->append(",channel=\"brightness\"} ");
+  append_float(out, brightness, 2);
+  out->push_back('\n');
+  this->begin_row_(out, "esphome_light_color", obj);
+  out->append(",channel=\"r\"} ");
+  append_float(out, r, 2);
+  out->push_back('\n');
+  this->begin_row_(out, "esphome_light_color", obj);
+  out->append(",channel=\"g\"} ");
+  append_float(out, g, 2);
+  out->push_back('\n');
+  this->begin_row_(out, "esphome_light_color", obj);
+  out->append(",channel=\"b\"} ");
+  append_float(out, b, 2);
+  out->push_back('\n');
+  this->begin_row_(out, "esphome_light_color", obj);
+  out->append(",channel=\"w\"} ");
+  append_float(out, w, 2);
+  out->push_back('\n');
   // Effect
   std::string effect = obj->get_effect_name();
+  this->begin_row_(out, "esphome_light_effect_active", obj);
   if (effect == "None") {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",effect=\"None\"} 0\n"));
+    out->append(",effect=\"None\"} 0\n");
   } else {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",effect=\""));
-    stream->print(effect.c_str());
-    stream->print(F("\"} 1\n"));
+    out->append(",effect=\"");
+    append_escaped(out, effect);
+    out->append("\"} 1\n");
   }
 }
 #endif
 
 #ifdef USE_COVER
-void PrometheusHandler::cover_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_cover_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_cover_failed GAUGE\n"));
+void PrometheusHandler::cover_type_(std::string *out) {
+  out->append("#TYPE esphome_cover_value GAUGE\n");
+  out->append("#TYPE esphome_cover_failed GAUGE\n");
 }
-void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj) {
+void PrometheusHandler::cover_row_(std::string *out, cover::Cover *obj) {
   if (obj->is_internal())
     return;
   if (!isnan(obj->position)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
+    this->begin_row_(out, "esphome_cover_failed", obj);
+    out->append("} 0\n");
     // Data itself
-    stream->print(F("esphome_cover_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->position);
-    stream->print('\n');
+    this->begin_row_(out, "esphome_cover_value", obj);
+    out->append("} ");
+    append_float(out, obj->position, 2);
+    out->push_back('\n');
     if (obj->get_traits().get_supports_tilt()) {
-      stream->print(F("esphome_cover_tilt{id=\""));
-      stream->print(obj->get_object_id().c_str());
-      stream->print(F("\",name=\""));
-      stream->print(obj->get_name().c_str());
-      stream->print(F("\"} "));
-      stream->print(obj->tilt);
-      stream->print('\n');
+      this->begin_row_(out, "esphome_cover_tilt", obj);
+      out->append("} ");
+      append_float(out, obj->tilt, 2);
+      out->push_back('\n');
     }
   } else {
     // Invalid state
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    this->begin_row_(out, "esphome_cover_failed", obj);
+    out->append("} 1\n");
   }
 }
 #endif
 
 #ifdef USE_SWITCH
-void PrometheusHandler::switch_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_switch_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_switch_failed GAUGE\n"));
+void PrometheusHandler::switch_type_(std::string *out) {
+  out->append("#TYPE esphome_switch_value GAUGE\n");
+  out->append("#TYPE esphome_switch_failed GAUGE\n");
 }
-void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj) {
+void PrometheusHandler::switch_row_(std::string *out, switch_::Switch *obj) {
   if (obj->is_internal())
     return;
-  stream->print(F("esphome_switch_failed{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} 0\n"));
+  this->begin_row_(out, "esphome_switch_failed", obj);
+  out->append("} 0\n");
+  // Data itself
+  this->begin_row_(out, "esphome_switch_value", obj);
+  out->append(obj->state ? "} 1\n" : "} 0\n");
+}
+#endif
+
+#ifdef USE_COMPONENT_PROFILER
+void PrometheusHandler::component_type_(std::string *out) {
+  out->append("#TYPE esphome_component_runtime_us HISTOGRAM\n");
+  out->append("#TYPE esphome_component_runtime_max_us GAUGE\n");
+  out->append("#TYPE esphome_component_setup_us GAUGE\n");
+}
+void PrometheusHandler::component_row_(std::string *out, Component *obj, uint32_t index) {
+  auto &stats = obj->get_runtime_stats();
+  if (stats.call_count == 0 && stats.setup_time_us == 0)
+    return;
+  // Several components can have the same source, the index in the application keeps them apart
+  std::string labels = "{source=\"";
+  append_escaped(&labels, obj->get_component_source());
+  labels += "\",index=\"";
+  append_uint(&labels, index);
+  labels += '"';
+
+  // Only every third bucket is exported to keep the response small
+  static const uint8_t EXPORTED_BUCKETS[] = {4, 7, 10, 13, 16};
+  uint32_t count = 0;
+  uint8_t bucket = 0;
+  for (uint8_t le : EXPORTED_BUCKETS) {
+    for (; bucket <= le; bucket++)
+      count += stats.histogram[bucket];
+    out->append("esphome_component_runtime_us_bucket");
+    out->append(labels);
+    out->append(",le=\"");
+    append_uint(out, 1UL << le);
+    out->append("\"} ");
+    append_uint(out, count);
+    out->push_back('\n');
+  }
+  out->append("esphome_component_runtime_us_bucket");
+  out->append(labels);
+  out->append(",le=\"+Inf\"} ");
+  append_uint(out, stats.call_count);
+  out->push_back('\n');
+  out->append("esphome_component_runtime_us_sum");
+  out->append(labels);
+  out->append("} ");
+  out->append(to_string(stats.total_time_us));
+  out->push_back('\n');
+  out->append("esphome_component_runtime_us_count");
+  out->append(labels);
+  out->append("} ");
+  append_uint(out, stats.call_count);
+  out->push_back('\n');
   // Data itself
-  stream->print(F("esphome_switch_value{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+  out->append("esphome_component_runtime_max_us");
+  out->append(labels);
+  out->append("} ");
+  append_uint(out, stats.max_time_us);
+  out->push_back('\n');
+  out->append("esphome_component_setup_us");
+  out->append(labels);
+  out->append("} ");
+  append_uint(out, stats.setup_time_us);
+  out->push_back('\n');
 }
 #endif
 
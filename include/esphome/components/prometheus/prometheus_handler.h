@@ -3,10 +3,22 @@
 #include "esphome/components/web_server_base/web_server_base.h"
 #include "esphome/core/controller.h"
 #include "esphome/core/component.h"
+#include <map>
 
 namespace esphome {
 namespace prometheus {
 
+/// State of one chunked /metrics response, the lines are rendered one section at a time while sending.
+struct PrometheusResponse {
+  /// The section that's rendered next, see PrometheusHandler::render_next_().
+  uint8_t section{0};
+  /// 0 for the type lines of the section, otherwise the index of the entity plus one.
+  uint32_t index{0};
+  /// Rendered lines that weren't sent yet.
+  std::string pending;
+  size_t offset{0};
+};
+
 class PrometheusHandler : public AsyncWebHandler, public Component {
  public:
   PrometheusHandler(web_server_base::WebServerBase *base) : base_(base) {}
@@ -22,59 +34,82 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
 
   void handleRequest(AsyncWebServerRequest *req) override;
 
-  void setup() override {
-    this->base_->init();
-    this->base_->add_handler(this);
-  }
+  void setup() override;
   float get_setup_priority() const override {
     // After WiFi
     return setup_priority::WIFI - 1.0f;
   }
 
  protected:
+  /// Copy the rendered lines into the buffer of the chunked response, returns 0 once everything was sent.
+  size_t fill_(PrometheusResponse *response, uint8_t *buffer, size_t max_len);
+  /// Render the next section or entity of the response, returns false when there's nothing left.
+  bool render_next_(PrometheusResponse *response);
+  template<typename T>
+  bool render_section_(PrometheusResponse *response, const std::vector<T *> &objs,
+                       void (PrometheusHandler::*type)(std::string *out),
+                       void (PrometheusHandler::*row)(std::string *out, T *obj));
+
+  /// Cache the escaped id and name labels of an entity.
+  void add_labels_(Nameable *obj);
+  /// Write the metric name and the cached labels of the entity, without the closing brace.
+  void begin_row_(std::string *out, const char *metric, Nameable *obj);
+
+  /// Return the runtime metrics of the node itself
+  void runtime_rows_(std::string *out);
+
 #ifdef USE_SENSOR
   /// Return the type for prometheus
-  void sensor_type_(AsyncResponseStream *stream);
+  void sensor_type_(std::string *out);
   /// Return the sensor state as prometheus data point
-  void sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj);
+  void sensor_row_(std::string *out, sensor::Sensor *obj);
 #endif
 
 #ifdef USE_BINARY_SENSOR
   /// Return the type for prometheus
-  void binary_sensor_type_(AsyncResponseStream *stream);
+  void binary_sensor_type_(std::string *out);
   /// Return the sensor state as prometheus data point
-  void binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj);
+  void binary_sensor_row_(std::string *out, binary_sensor::BinarySensor *obj);
 #endif
 
 #ifdef USE_FAN
   /// Return the type for prometheus
-  void fan_type_(AsyncResponseStream *stream);
+  void fan_type_(std::string *out);
   /// Return the sensor state as prometheus data point
-  void fan_row_(AsyncResponseStream *stream, fan::FanState *obj);
+  void fan_row_(std::string *out, fan::FanState *obj);
 #endif
 
 #ifdef USE_LIGHT
   /// Return the type for prometheus
-  void light_type_(AsyncResponseStream *stream);
+  void light_type_(std::string *out);
   /// Return the Light Values state as prometheus data point
-  void light_row_(AsyncResponseStream *stream, light::LightState *obj);
+  void light_row_(std::string *out, light::LightState *obj);
 #endif
 
 #ifdef USE_COVER
   /// Return the type for prometheus
-  void cover_type_(AsyncResponseStream *stream);
+  void cover_type_(std::string *out);
   /// Return the switch Values state as prometheus data point
-  void cover_row_(AsyncResponseStream *stream, cover::Cover *obj);
+  void cover_row_(std::string *out, cover::Cover *obj);
 #endif
 
 #ifdef USE_SWITCH
   /// Return the type for prometheus
-  void switch_type_(AsyncResponseStream *stream);
+  void switch_type_(std::string *out);
   /// Return the switch Values state as prometheus data point
-  void switch_row_(AsyncResponseStream *stream, switch_::Switch *obj);
+  void switch_row_(std::string *out, switch_::Switch *obj);
+#endif
+
+#ifdef USE_COMPONENT_PROFILER
+  /// Return the type for prometheus
+  void component_type_(std::string *out);
+  /// Return the runtime statistics of a component as prometheus data points
+  void component_row_(std::string *out, Component *obj, uint32_t index);
 #endif
 
   web_server_base::WebServerBase *base_;
+  /// The id and name labels of every entity, rendered and escaped once at setup.
+  std::map<Nameable *, std::string> labels_;
 };
 
 }  // namespace prometheus
@@ -25,6 +25,7 @@ from esphome.const import (
     CONF_STATE_CLASS,
     CONF_TO,
     CONF_TRIGGER_ID,
+    CONF_TYPE_ID,
     CONF_UNIT_OF_MEASUREMENT,
     CONF_WINDOW_SIZE,
     CONF_NAME,
@@ -95,6 +96,17 @@ def validate_send_first_at(value):
 
 FILTER_REGISTRY = Registry()
 validate_filters = cv.validate_registry("filter", FILTER_REGISTRY)
+# Filters that can be fused into a FusedFilter, maps the filter name to a function
+# returning the type and constructor expression of its stage.
+FUSED_FILTER_STAGES = {}
+
+
+def register_filter_stage(name, stage_type):
+    def decorator(fun):
+        FUSED_FILTER_STAGES[name] = lambda config: (stage_type, fun(config))
+        return fun
+
+    return decorator
 
 
 def validate_datapoint(value):
@@ -152,6 +164,13 @@ DeltaFilter = sensor_ns.class_("DeltaFilter", Filter)
 OrFilter = sensor_ns.class_("OrFilter", Filter)
 CalibrateLinearFilter = sensor_ns.class_("CalibrateLinearFilter", Filter)
 CalibratePolynomialFilter = sensor_ns.class_("CalibratePolynomialFilter", Filter)
+FusedFilter = sensor_ns.class_("FusedFilter", Filter)
+OffsetStage = sensor_ns.class_("OffsetStage")
+MultiplyStage = sensor_ns.class_("MultiplyStage")
+CalibrateLinearStage = sensor_ns.class_("CalibrateLinearStage")
+DeltaStage = sensor_ns.class_("DeltaStage")
+ThrottleStage = sensor_ns.class_("ThrottleStage")
+ExponentialMovingAverageStage = sensor_ns.class_("ExponentialMovingAverageStage")
 SensorInRangeCondition = sensor_ns.class_("SensorInRangeCondition", Filter)
 
 unit_of_measurement = cv.string_strict
@@ -238,11 +257,21 @@ async def offset_filter_to_code(config, filter_id):
     return cg.new_Pvariable(filter_id, config)
 
 
+@register_filter_stage("offset", OffsetStage)
+def offset_filter_stage(config):
+    return OffsetStage(config)
+
+
 @FILTER_REGISTRY.register("multiply", MultiplyFilter, cv.float_)
 async def multiply_filter_to_code(config, filter_id):
     return cg.new_Pvariable(filter_id, config)
 
 
+@register_filter_stage("multiply", MultiplyStage)
+def multiply_filter_stage(config):
+    return MultiplyStage(config)
+
+
 @FILTER_REGISTRY.register("filter_out", FilterOutValueFilter, cv.float_)
 async def filter_out_filter_to_code(config, filter_id):
     return cg.new_Pvariable(filter_id, config)
@@ -354,6 +383,11 @@ async def exponential_moving_average_filter_to_code(config, filter_id):
     return cg.new_Pvariable(filter_id, config[CONF_ALPHA], config[CONF_SEND_EVERY])
 
 
+@register_filter_stage("exponential_moving_average", ExponentialMovingAverageStage)
+def exponential_moving_average_filter_stage(config):
+    return ExponentialMovingAverageStage(config[CONF_ALPHA], config[CONF_SEND_EVERY])
+
+
 @FILTER_REGISTRY.register("lambda", LambdaFilter, cv.returning_lambda)
 async def lambda_filter_to_code(config, filter_id):
     lambda_ = await cg.process_lambda(
@@ -367,6 +401,11 @@ async def delta_filter_to_code(config, filter_id):
     return cg.new_Pvariable(filter_id, config)
 
 
+@register_filter_stage("delta", DeltaStage)
+def delta_filter_stage(config):
+    return DeltaStage(config)
+
+
 @FILTER_REGISTRY.register("or", OrFilter, validate_filters)
 async def or_filter_to_code(config, filter_id):
     filters = await build_filters(config)
@@ -380,6 +419,11 @@ async def throttle_filter_to_code(config, filter_id):
     return cg.new_Pvariable(filter_id, config)
 
 
+@register_filter_stage("throttle", ThrottleStage)
+def throttle_filter_stage(config):
+    return ThrottleStage(config)
+
+
 @FILTER_REGISTRY.register(
     "heartbeat", HeartbeatFilter, cv.positive_time_period_milliseconds
 )
@@ -415,10 +459,20 @@ def validate_not_all_from_same(config):
     ),
 )
 async def calibrate_linear_filter_to_code(config, filter_id):
+    k, b = fit_datapoints_linear(config)
+    return cg.new_Pvariable(filter_id, k, b)
+
+
+@register_filter_stage("calibrate_linear", CalibrateLinearStage)
+def calibrate_linear_filter_stage(config):
+    k, b = fit_datapoints_linear(config)
+    return CalibrateLinearStage(k, b)
+
+
+def fit_datapoints_linear(config):
     x = [conf[CONF_FROM] for conf in config]
     y = [conf[CONF_TO] for conf in config]
-    k, b = fit_linear(x, y)
-    return cg.new_Pvariable(filter_id, k, b)
+    return fit_linear(x, y)
 
 
 CONF_DATAPOINTS = "datapoints"
@@ -461,8 +515,41 @@ async def calibrate_polynomial_filter_to_code(config, filter_id):
     return cg.new_Pvariable(filter_id, res)
 
 
+async def build_fused_filter(full_configs):
+    stages = []
+    for full_config in full_configs:
+        registry_entry, config = cg.extract_registry_entry_config(
+            FILTER_REGISTRY, full_config
+        )
+        stages.append(FUSED_FILTER_STAGES[registry_entry.name](config))
+    fused_type = FusedFilter.template(*[type_ for type_, _ in stages])
+    rhs = fused_type.new(*[stage for _, stage in stages])
+    return cg.Pvariable(full_configs[0][CONF_TYPE_ID], rhs, fused_type)
+
+
 async def build_filters(config):
-    return await cg.build_registry_list(FILTER_REGISTRY, config)
+    # Consecutive filters that have a stage are fused into a single FusedFilter
+    filters = []
+    pending = []
+
+    async def flush():
+        if len(pending) == 1:
+            filters.append(await cg.build_registry_entry(FILTER_REGISTRY, pending[0]))
+        elif pending:
+            filters.append(await build_fused_filter(pending))
+        pending.clear()
+
+    for full_config in config:
+        registry_entry, _ = cg.extract_registry_entry_config(
+            FILTER_REGISTRY, full_config
+        )
+        if registry_entry.name in FUSED_FILTER_STAGES:
+            pending.append(full_config)
+            continue
+        await flush()
+        filters.append(await cg.build_registry_entry(FILTER_REGISTRY, full_config))
+    await flush()
+    return filters
 
 
 async def setup_sensor_core_(var, config):
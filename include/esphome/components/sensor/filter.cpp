@@ -39,171 +39,189 @@ uint32_t Filter::calculate_remaining_interval(uint32_t input) {
   }
 }
 
-// MedianFilter
-MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
-void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> MedianFilter::new_value(float value) {
+// SlidingWindowFilter
+SlidingWindowFilter::SlidingWindowFilter(size_t window_size, size_t send_every, size_t send_first_at)
+    : values_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
+void SlidingWindowFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
+void SlidingWindowFilter::set_window_size(size_t window_size) {
+  this->values_.resize(window_size);
+  this->head_ = 0;
+  this->count_ = 0;
+  this->resize_window_(window_size);
+}
+optional<float> SlidingWindowFilter::new_value(float value) {
   if (!isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
+    const size_t window_size = this->values_.size();
+    size_t slot;
+    if (this->count_ == window_size) {
+      slot = this->head_;
+      this->remove_(slot);
+      if (++this->head_ == window_size)
+        this->head_ = 0;
+    } else {
+      slot = this->head_ + this->count_++;
+      if (slot >= window_size)
+        slot -= window_size;
     }
-    this->queue_.push_back(value);
-    ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
+    this->values_[slot] = value;
+    this->insert_(slot);
+    ESP_LOGVV(TAG, "SlidingWindowFilter(%p)::new_value(%f)", this, value);
   }
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float median = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float> median_queue = this->queue_;
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size % 2) {
-        median = median_queue[queue_size / 2];
-      } else {
-        median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
-      }
-    }
+    float result = 0.0f;
+    if (this->count_ != 0)
+      result = this->compute_();
 
-    ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f) SENDING", this, median);
-    return median;
+    ESP_LOGVV(TAG, "SlidingWindowFilter(%p)::new_value(%f) SENDING %f", this, value, result);
+    return result;
   }
   return {};
 }
+uint32_t SlidingWindowFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
 
-uint32_t MedianFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
-
-// MinFilter
-MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
-void MinFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MinFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> MinFilter::new_value(float value) {
-  if (!isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
-    ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f)", this, value);
+// MedianFilter
+MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
+    : SlidingWindowFilter(window_size, send_every, send_first_at),
+      lower_(window_size),
+      upper_(window_size),
+      positions_(window_size) {}
+void MedianFilter::resize_window_(size_t window_size) {
+  this->lower_.resize(window_size);
+  this->upper_.resize(window_size);
+  this->positions_.resize(window_size);
+  this->lower_size_ = 0;
+  this->upper_size_ = 0;
+}
+void MedianFilter::insert_(size_t slot) {
+  // values that are at least as large as the largest one of the lower half go into the upper half
+  const bool upper = this->lower_size_ != 0 && !this->above_(false, this->lower_[0], slot);
+  this->heap_push_(upper, slot);
+  this->rebalance_();
+}
+void MedianFilter::remove_(size_t slot) {
+  const HeapPosition position = this->positions_[slot];
+  this->heap_erase_(position.upper, position.index);
+  this->rebalance_();
+}
+float MedianFilter::compute_() {
+  const float lower = this->values_[this->lower_[0]];
+  if (this->lower_size_ > this->upper_size_)
+    return lower;
+  return (lower + this->values_[this->upper_[0]]) / 2.0f;
+}
+void MedianFilter::heap_set_(bool upper, size_t index, size_t slot) {
+  (upper ? this->upper_ : this->lower_)[index] = slot;
+  this->positions_[slot] = HeapPosition{index, upper};
+}
+void MedianFilter::heap_push_(bool upper, size_t slot) {
+  size_t &size = upper ? this->upper_size_ : this->lower_size_;
+  const size_t index = size++;
+  this->heap_set_(upper, index, slot);
+  this->sift_up_(upper, index);
+}
+size_t MedianFilter::heap_erase_(bool upper, size_t index) {
+  std::vector<size_t> &heap = upper ? this->upper_ : this->lower_;
+  size_t &size = upper ? this->upper_size_ : this->lower_size_;
+  const size_t slot = heap[index];
+  const size_t last = heap[--size];
+  if (index != size) {
+    // fill the gap with the last entry and restore the heap order around it
+    this->heap_set_(upper, index, last);
+    this->sift_up_(upper, index);
+    this->sift_down_(upper, this->positions_[last].index);
   }
-
-  if (++this->send_at_ >= this->send_every_) {
-    this->send_at_ = 0;
-
-    float min = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float>::iterator it = std::min_element(queue_.begin(), queue_.end());
-      min = *it;
-    }
-
-    ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f) SENDING", this, min);
-    return min;
+  return slot;
+}
+void MedianFilter::sift_up_(bool upper, size_t index) {
+  std::vector<size_t> &heap = upper ? this->upper_ : this->lower_;
+  const size_t slot = heap[index];
+  while (index != 0) {
+    const size_t parent = (index - 1) / 2;
+    if (!this->above_(upper, slot, heap[parent]))
+      break;
+    this->heap_set_(upper, index, heap[parent]);
+    index = parent;
   }
-  return {};
+  this->heap_set_(upper, index, slot);
+}
+void MedianFilter::sift_down_(bool upper, size_t index) {
+  std::vector<size_t> &heap = upper ? this->upper_ : this->lower_;
+  const size_t size = upper ? this->upper_size_ : this->lower_size_;
+  const size_t slot = heap[index];
+  while (true) {
+    size_t child = 2 * index + 1;
+    if (child >= size)
+      break;
+    if (child + 1 < size && this->above_(upper, heap[child + 1], heap[child]))
+      child++;
+    if (!this->above_(upper, heap[child], slot))
+      break;
+    this->heap_set_(upper, index, heap[child]);
+    index = child;
+  }
+  this->heap_set_(upper, index, slot);
+}
+void MedianFilter::rebalance_() {
+  while (this->lower_size_ > this->upper_size_ + 1)
+    this->heap_push_(true, this->heap_erase_(false, 0));
+  while (this->upper_size_ > this->lower_size_)
+    this->heap_push_(false, this->heap_erase_(true, 0));
 }
 
-uint32_t MinFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
+// MinFilter
+MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at)
+    : ExtremumFilter(window_size, send_every, send_first_at) {}
 
 // MaxFilter
 MaxFilter::MaxFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
-void MaxFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MaxFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> MaxFilter::new_value(float value) {
-  if (!isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
-    ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f)", this, value);
-  }
-
-  if (++this->send_at_ >= this->send_every_) {
-    this->send_at_ = 0;
-
-    float max = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float>::iterator it = std::max_element(queue_.begin(), queue_.end());
-      max = *it;
-    }
-
-    ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f) SENDING", this, max);
-    return max;
-  }
-  return {};
-}
-
-uint32_t MaxFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
+    : ExtremumFilter(window_size, send_every, send_first_at) {}
 
 // SlidingWindowMovingAverageFilter
 SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every,
                                                                    size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
-void SlidingWindowMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
-  if (!isnan(value)) {
-    if (this->queue_.size() == this->window_size_) {
-      this->sum_ -= this->queue_[0];
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
-    this->sum_ += value;
-  }
-  float average;
-  if (this->queue_.empty())
-    average = 0.0f;
-  else
-    average = this->sum_ / this->queue_.size();
-  ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f) -> %f", this, value, average);
-
-  if (++this->send_at_ % this->send_every_ == 0) {
-    if (this->send_at_ >= 10000) {
-      // Recalculate to prevent floating point error accumulating
-      this->sum_ = 0;
-      for (auto v : this->queue_)
-        this->sum_ += v;
-      average = this->sum_ / this->queue_.size();
-      this->send_at_ = 0;
-    }
-
-    ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f) SENDING", this, value);
-    return average;
+    : SlidingWindowFilter(window_size, send_every, send_first_at) {}
+void SlidingWindowMovingAverageFilter::resize_window_(size_t window_size) {
+  this->sum_ = 0.0f;
+  this->removed_ = 0;
+}
+void SlidingWindowMovingAverageFilter::insert_(size_t slot) { this->sum_ += this->values_[slot]; }
+void SlidingWindowMovingAverageFilter::remove_(size_t slot) {
+  this->sum_ -= this->values_[slot];
+  this->removed_++;
+}
+float SlidingWindowMovingAverageFilter::compute_() {
+  if (this->removed_ >= this->values_.size()) {
+    // Recalculate to prevent floating point error accumulating
+    this->sum_ = 0.0f;
+    for (size_t i = 0; i < this->count_; i++)
+      this->sum_ += this->values_[i];
+    this->removed_ = 0;
   }
-  return {};
+  return this->sum_ / this->count_;
 }
 
-uint32_t SlidingWindowMovingAverageFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
-
 // ExponentialMovingAverageFilter
 ExponentialMovingAverageFilter::ExponentialMovingAverageFilter(float alpha, size_t send_every)
-    : send_every_(send_every), send_at_(send_every - 1), alpha_(alpha) {}
+    : stage_(alpha, send_every) {}
 optional<float> ExponentialMovingAverageFilter::new_value(float value) {
-  if (!isnan(value)) {
-    if (this->first_value_)
-      this->accumulator_ = value;
-    else
-      this->accumulator_ = (this->alpha_ * value) + (1.0f - this->alpha_) * this->accumulator_;
-    this->first_value_ = false;
-  }
-
-  float average = this->accumulator_;
-  ESP_LOGVV(TAG, "ExponentialMovingAverageFilter(%p)::new_value(%f) -> %f", this, value, average);
+  float average = value;
+  const bool send = this->stage_.apply(average);
+  ESP_LOGVV(TAG, "ExponentialMovingAverageFilter(%p)::new_value(%f) -> %f", this, value, this->stage_.accumulator);
 
-  if (++this->send_at_ >= this->send_every_) {
+  if (send) {
     ESP_LOGVV(TAG, "ExponentialMovingAverageFilter(%p)::new_value(%f) SENDING", this, value);
-    this->send_at_ = 0;
     return average;
   }
   return {};
 }
-void ExponentialMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void ExponentialMovingAverageFilter::set_alpha(float alpha) { this->alpha_ = alpha; }
-uint32_t ExponentialMovingAverageFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
+void ExponentialMovingAverageFilter::set_send_every(size_t send_every) { this->stage_.send_every = send_every; }
+void ExponentialMovingAverageFilter::set_alpha(float alpha) { this->stage_.alpha = alpha; }
+uint32_t ExponentialMovingAverageFilter::expected_interval(uint32_t input) {
+  return this->stage_.expected_interval(input);
+}
 
 // LambdaFilter
 LambdaFilter::LambdaFilter(lambda_filter_t lambda_filter) : lambda_filter_(std::move(lambda_filter)) {}
@@ -217,14 +235,20 @@ optional<float> LambdaFilter::new_value(float value) {
 }
 
 // OffsetFilter
-OffsetFilter::OffsetFilter(float offset) : offset_(offset) {}
+OffsetFilter::OffsetFilter(float offset) : stage_(offset) {}
 
-optional<float> OffsetFilter::new_value(float value) { return value + this->offset_; }
+optional<float> OffsetFilter::new_value(float value) {
+  this->stage_.apply(value);
+  return value;
+}
 
 // MultiplyFilter
-MultiplyFilter::MultiplyFilter(float multiplier) : multiplier_(multiplier) {}
+MultiplyFilter::MultiplyFilter(float multiplier) : stage_(multiplier) {}
 
-optional<float> MultiplyFilter::new_value(float value) { return value * this->multiplier_; }
+optional<float> MultiplyFilter::new_value(float value) {
+  this->stage_.apply(value);
+  return value;
+}
 
 // FilterOutValueFilter
 FilterOutValueFilter::FilterOutValueFilter(float value_to_filter_out) : value_to_filter_out_(value_to_filter_out) {}
@@ -248,29 +272,19 @@ optional<float> FilterOutValueFilter::new_value(float value) {
 }
 
 // ThrottleFilter
-ThrottleFilter::ThrottleFilter(uint32_t min_time_between_inputs)
-    : Filter(), min_time_between_inputs_(min_time_between_inputs) {}
+ThrottleFilter::ThrottleFilter(uint32_t min_time_between_inputs) : Filter(), stage_(min_time_between_inputs) {}
 optional<float> ThrottleFilter::new_value(float value) {
-  const uint32_t now = millis();
-  if (this->last_input_ == 0 || now - this->last_input_ >= min_time_between_inputs_) {
-    this->last_input_ = now;
-    return value;
-  }
-  return {};
+  if (!this->stage_.apply(value))
+    return {};
+  return value;
 }
 
 // DeltaFilter
-DeltaFilter::DeltaFilter(float min_delta) : min_delta_(min_delta), last_value_(NAN) {}
+DeltaFilter::DeltaFilter(float min_delta) : stage_(min_delta) {}
 optional<float> DeltaFilter::new_value(float value) {
-  if (isnan(value))
+  if (!this->stage_.apply(value))
     return {};
-  if (isnan(this->last_value_)) {
-    return this->last_value_ = value;
-  }
-  if (fabsf(value - this->last_value_) >= this->min_delta_) {
-    return this->last_value_ = value;
-  }
-  return {};
+  return value;
 }
 
 // OrFilter
@@ -337,8 +351,11 @@ void HeartbeatFilter::setup() {
 }
 float HeartbeatFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
 
-optional<float> CalibrateLinearFilter::new_value(float value) { return value * this->slope_ + this->bias_; }
-CalibrateLinearFilter::CalibrateLinearFilter(float slope, float bias) : slope_(slope), bias_(bias) {}
+optional<float> CalibrateLinearFilter::new_value(float value) {
+  this->stage_.apply(value);
+  return value;
+}
+CalibrateLinearFilter::CalibrateLinearFilter(float slope, float bias) : stage_(slope, bias) {}
 
 optional<float> CalibratePolynomialFilter::new_value(float value) {
   float res = 0.0f;
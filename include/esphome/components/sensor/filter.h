@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
+#include <functional>
 #include <queue>
 #include <utility>
 
@@ -47,71 +48,286 @@ class Filter {
   Sensor *parent_{nullptr};
 };
 
-/** Simple median filter.
+/** Base class of the filter stages.
+ *
+ * A stage holds the logic and state of a simple filter without the linked list node and virtual dispatch of Filter.
+ * The filters that are built from a stage wrap it, and FusedFilter runs several stages in a row with inlined calls.
  *
- * Takes the median of the last <send_every> values and pushes it out every <send_every>.
+ * A stage implements `bool apply(float &value)`, which modifies the value in place and returns false if the value
+ * should be discarded, and can hide expected_interval() if it doesn't forward every value.
  */
-class MedianFilter : public Filter {
+struct FilterStage {
+  uint32_t expected_interval(uint32_t input) const { return input; }
+};
+
+/// Adds `offset` to each value, the stage of OffsetFilter.
+struct OffsetStage : public FilterStage {
+  explicit OffsetStage(float offset) : offset(offset) {}
+  bool apply(float &value) {
+    value += this->offset;
+    return true;
+  }
+
+  float offset;
+};
+
+/// Multiplies each value by `multiplier`, the stage of MultiplyFilter.
+struct MultiplyStage : public FilterStage {
+  explicit MultiplyStage(float multiplier) : multiplier(multiplier) {}
+  bool apply(float &value) {
+    value *= this->multiplier;
+    return true;
+  }
+
+  float multiplier;
+};
+
+/// Maps each value onto a line with `slope` and `bias`, the stage of CalibrateLinearFilter.
+struct CalibrateLinearStage : public FilterStage {
+  CalibrateLinearStage(float slope, float bias) : slope(slope), bias(bias) {}
+  bool apply(float &value) {
+    value = value * this->slope + this->bias;
+    return true;
+  }
+
+  float slope;
+  float bias;
+};
+
+/// Only forwards values that differ by at least `min_delta` from the last forwarded one, the stage of DeltaFilter.
+struct DeltaStage : public FilterStage {
+  explicit DeltaStage(float min_delta) : min_delta(min_delta) {}
+  bool apply(float &value) {
+    if (isnan(value))
+      return false;
+    if (isnan(this->last_value) || fabsf(value - this->last_value) >= this->min_delta) {
+      this->last_value = value;
+      return true;
+    }
+    return false;
+  }
+
+  float min_delta;
+  float last_value{NAN};
+};
+
+/// Only forwards a value if the last one was forwarded at least `min_time_between_inputs` ago, the stage of
+/// ThrottleFilter.
+struct ThrottleStage : public FilterStage {
+  explicit ThrottleStage(uint32_t min_time_between_inputs) : min_time_between_inputs(min_time_between_inputs) {}
+  bool apply(float &value) {
+    const uint32_t now = millis();
+    if (this->last_input == 0 || now - this->last_input >= this->min_time_between_inputs) {
+      this->last_input = now;
+      return true;
+    }
+    return false;
+  }
+
+  uint32_t last_input{0};
+  uint32_t min_time_between_inputs;
+};
+
+/// Exponential moving average that's forwarded every `send_every` values, the stage of ExponentialMovingAverageFilter.
+struct ExponentialMovingAverageStage : public FilterStage {
+  ExponentialMovingAverageStage(float alpha, size_t send_every)
+      : send_every(send_every), send_at(send_every - 1), alpha(alpha) {}
+  bool apply(float &value) {
+    if (!isnan(value)) {
+      if (this->first_value)
+        this->accumulator = value;
+      else
+        this->accumulator = (this->alpha * value) + (1.0f - this->alpha) * this->accumulator;
+      this->first_value = false;
+    }
+
+    if (++this->send_at >= this->send_every) {
+      this->send_at = 0;
+      value = this->accumulator;
+      return true;
+    }
+    return false;
+  }
+  uint32_t expected_interval(uint32_t input) const { return input * this->send_every; }
+
+  bool first_value{true};
+  float accumulator{0.0f};
+  size_t send_every;
+  size_t send_at;
+  float alpha;
+};
+
+/** Base class of the filters that are calculated over a sliding window of the last values.
+ *
+ * The values are kept in a ring buffer that's allocated once for the window size. Subclasses are notified about every
+ * value that enters or leaves the window, so they can update their result incrementally instead of rescanning the
+ * whole window. NaN values are not added to the window.
+ */
+class SlidingWindowFilter : public Filter {
  public:
-  /** Construct a MedianFilter.
+  /** Construct a SlidingWindowFilter.
    *
-   * @param window_size The number of values that should be used in median calculation.
+   * @param window_size The number of values that the result is calculated over.
    * @param send_every After how many sensor values should a new one be pushed out.
    * @param send_first_at After how many values to forward the very first value. Defaults to the first value
    *   on startup being published on the first *raw* value, so with no filter applied. Must be less than or equal to
    *   send_every.
    */
-  explicit MedianFilter(size_t window_size, size_t send_every, size_t send_first_at);
+  SlidingWindowFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
 
   void set_send_every(size_t send_every);
+  /// Change the size of the window, this clears the values in it.
   void set_window_size(size_t window_size);
 
   uint32_t expected_interval(uint32_t input) override;
 
  protected:
-  std::deque<float> queue_;
+  /// Reallocate the buffers of the subclass for a new window size, the window is empty afterwards.
+  virtual void resize_window_(size_t window_size) {}
+  /// The value in values_[slot] was added to the window.
+  virtual void insert_(size_t slot) = 0;
+  /// The value in values_[slot] is about to leave the window.
+  virtual void remove_(size_t slot) = 0;
+  /// Calculate the result over the values in the window, only called if the window isn't empty.
+  virtual float compute_() = 0;
+
+  std::vector<float> values_;
+  /// The slot of the oldest value in the window.
+  size_t head_{0};
+  size_t count_{0};
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
-/** Simple min filter.
+/** Simple median filter.
+ *
+ * Takes the median of the last <window_size> values and pushes it out every <send_every>.
  *
- * Takes the min of the last <send_every> values and pushes it out every <send_every>.
+ * The lower half of the window is kept in a max-heap and the upper half in a min-heap, the median is at the top of
+ * the heaps. Adding and removing a value only takes O(log n).
  */
-class MinFilter : public Filter {
+class MedianFilter : public SlidingWindowFilter {
  public:
-  /** Construct a MinFilter.
+  /** Construct a MedianFilter.
    *
-   * @param window_size The number of values that the min should be returned from.
+   * @param window_size The number of values that should be used in median calculation.
    * @param send_every After how many sensor values should a new one be pushed out.
    * @param send_first_at After how many values to forward the very first value. Defaults to the first value
    *   on startup being published on the first *raw* value, so with no filter applied. Must be less than or equal to
    *   send_every.
    */
-  explicit MinFilter(size_t window_size, size_t send_every, size_t send_first_at);
+  explicit MedianFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
-  optional<float> new_value(float value) override;
+ protected:
+  /// Where the value of a slot of the window is stored in the heaps.
+  struct HeapPosition {
+    size_t index;
+    bool upper;
+  };
 
-  void set_send_every(size_t send_every);
-  void set_window_size(size_t window_size);
+  void resize_window_(size_t window_size) override;
+  void insert_(size_t slot) override;
+  void remove_(size_t slot) override;
+  float compute_() override;
+
+  /// Whether the value of slot a belongs closer to the top of the heap than the one of slot b.
+  bool above_(bool upper, size_t a, size_t b) const {
+    return upper ? this->values_[a] < this->values_[b] : this->values_[a] > this->values_[b];
+  }
+  void heap_set_(bool upper, size_t index, size_t slot);
+  void heap_push_(bool upper, size_t slot);
+  /// Remove the entry at index from the heap and return its slot.
+  size_t heap_erase_(bool upper, size_t index);
+  void sift_up_(bool upper, size_t index);
+  void sift_down_(bool upper, size_t index);
+  /// Move values between the heaps until the lower one has as many or one more value than the upper one.
+  void rebalance_();
+
+  /// The slots of the lower and upper half of the window, the first lower_size_/upper_size_ entries are used.
+  std::vector<size_t> lower_;
+  std::vector<size_t> upper_;
+  size_t lower_size_{0};
+  size_t upper_size_{0};
+  /// The position of each slot of the window in the heaps.
+  std::vector<HeapPosition> positions_;
+};
 
-  uint32_t expected_interval(uint32_t input) override;
+/** Base class of MinFilter and MaxFilter.
+ *
+ * The slots of the values that can still become the extremum of the window are kept in a monotonic queue. A value is
+ * dropped from it as soon as a newer one that's at least as extreme arrives, because the newer one stays longer in
+ * the window. The extremum is always at the front of the queue.
+ *
+ * @tparam Compare Returns true if the first value is more extreme than the second one.
+ */
+template<typename Compare> class ExtremumFilter : public SlidingWindowFilter {
+ public:
+  ExtremumFilter(size_t window_size, size_t send_every, size_t send_first_at)
+      : SlidingWindowFilter(window_size, send_every, send_first_at), queue_(window_size) {}
 
  protected:
-  std::deque<float> queue_;
-  size_t send_every_;
-  size_t send_at_;
-  size_t window_size_;
+  void resize_window_(size_t window_size) override {
+    this->queue_.resize(window_size);
+    this->queue_head_ = 0;
+    this->queue_count_ = 0;
+  }
+  void insert_(size_t slot) override {
+    const float value = this->values_[slot];
+    // drop the values that can't become the extremum anymore, starting at the newest one
+    while (this->queue_count_ != 0) {
+      const size_t back = this->queue_[this->queue_index_(this->queue_count_ - 1)];
+      if (Compare()(this->values_[back], value))
+        break;
+      this->queue_count_--;
+    }
+    this->queue_[this->queue_index_(this->queue_count_++)] = slot;
+  }
+  void remove_(size_t slot) override {
+    // the oldest value of the window is at the front of the queue, if it's still in it
+    if (this->queue_count_ != 0 && this->queue_[this->queue_head_] == slot) {
+      if (++this->queue_head_ == this->queue_.size())
+        this->queue_head_ = 0;
+      this->queue_count_--;
+    }
+  }
+  float compute_() override { return this->values_[this->queue_[this->queue_head_]]; }
+
+  /// The index in queue_ of the n-th entry of the queue.
+  size_t queue_index_(size_t n) const {
+    const size_t index = this->queue_head_ + n;
+    return index >= this->queue_.size() ? index - this->queue_.size() : index;
+  }
+
+  /// Ring buffer of slots of the window, ordered from the oldest to the newest.
+  std::vector<size_t> queue_;
+  size_t queue_head_{0};
+  size_t queue_count_{0};
+};
+
+/** Simple min filter.
+ *
+ * Takes the min of the last <window_size> values and pushes it out every <send_every>.
+ */
+class MinFilter : public ExtremumFilter<std::less<float>> {
+ public:
+  /** Construct a MinFilter.
+   *
+   * @param window_size The number of values that the min should be returned from.
+   * @param send_every After how many sensor values should a new one be pushed out.
+   * @param send_first_at After how many values to forward the very first value. Defaults to the first value
+   *   on startup being published on the first *raw* value, so with no filter applied. Must be less than or equal to
+   *   send_every.
+   */
+  explicit MinFilter(size_t window_size, size_t send_every, size_t send_first_at);
 };
 
 /** Simple max filter.
  *
- * Takes the max of the last <send_every> values and pushes it out every <send_every>.
+ * Takes the max of the last <window_size> values and pushes it out every <send_every>.
  */
-class MaxFilter : public Filter {
+class MaxFilter : public ExtremumFilter<std::greater<float>> {
  public:
   /** Construct a MaxFilter.
    *
@@ -122,27 +338,17 @@ class MaxFilter : public Filter {
    *   send_every.
    */
   explicit MaxFilter(size_t window_size, size_t send_every, size_t send_first_at);
-
-  optional<float> new_value(float value) override;
-
-  void set_send_every(size_t send_every);
-  void set_window_size(size_t window_size);
-
-  uint32_t expected_interval(uint32_t input) override;
-
- protected:
-  std::deque<float> queue_;
-  size_t send_every_;
-  size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple sliding window moving average filter.
  *
  * Essentially just takes takes the average of the last window_size values and pushes them out
  * every send_every.
+ *
+ * A running sum is kept, it's recalculated from the window once all values in it were replaced to keep floating point
+ * errors from accumulating.
  */
-class SlidingWindowMovingAverageFilter : public Filter {
+class SlidingWindowMovingAverageFilter : public SlidingWindowFilter {
  public:
   /** Construct a SlidingWindowMovingAverageFilter.
    *
@@ -154,19 +360,15 @@ class SlidingWindowMovingAverageFilter : public Filter {
    */
   explicit SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
-  optional<float> new_value(float value) override;
-
-  void set_send_every(size_t send_every);
-  void set_window_size(size_t window_size);
-
-  uint32_t expected_interval(uint32_t input) override;
-
  protected:
+  void resize_window_(size_t window_size) override;
+  void insert_(size_t slot) override;
+  void remove_(size_t slot) override;
+  float compute_() override;
+
   float sum_{0.0};
-  std::deque<float> queue_;
-  size_t send_every_;
-  size_t send_at_;
-  size_t window_size_;
+  /// The number of values that were removed from the sum since it was last recalculated.
+  size_t removed_{0};
 };
 
 /** Simple exponential moving average filter.
@@ -186,11 +388,7 @@ class ExponentialMovingAverageFilter : public Filter {
   uint32_t expected_interval(uint32_t input) override;
 
  protected:
-  bool first_value_{true};
-  float accumulator_{0.0f};
-  size_t send_every_;
-  size_t send_at_;
-  float alpha_;
+  ExponentialMovingAverageStage stage_;
 };
 
 using lambda_filter_t = std::function<optional<float>(float)>;
@@ -223,7 +421,7 @@ class OffsetFilter : public Filter {
   optional<float> new_value(float value) override;
 
  protected:
-  float offset_;
+  OffsetStage stage_;
 };
 
 /// A simple filter that multiplies to each value it receives by `multiplier`.
@@ -234,7 +432,7 @@ class MultiplyFilter : public Filter {
   optional<float> new_value(float value) override;
 
  protected:
-  float multiplier_;
+  MultiplyStage stage_;
 };
 
 /// A simple filter that only forwards the filter chain if it doesn't receive `value_to_filter_out`.
@@ -255,8 +453,7 @@ class ThrottleFilter : public Filter {
   optional<float> new_value(float value) override;
 
  protected:
-  uint32_t last_input_{0};
-  uint32_t min_time_between_inputs_;
+  ThrottleStage stage_;
 };
 
 class DebounceFilter : public Filter, public Component {
@@ -296,8 +493,7 @@ class DeltaFilter : public Filter {
   optional<float> new_value(float value) override;
 
  protected:
-  float min_delta_;
-  float last_value_{NAN};
+  DeltaStage stage_;
 };
 
 class OrFilter : public Filter {
@@ -330,8 +526,7 @@ class CalibrateLinearFilter : public Filter {
   optional<float> new_value(float value) override;
 
  protected:
-  float slope_;
-  float bias_;
+  CalibrateLinearStage stage_;
 };
 
 class CalibratePolynomialFilter : public Filter {
@@ -343,5 +538,49 @@ class CalibratePolynomialFilter : public Filter {
   std::vector<float> coefficients_;
 };
 
+/// A list of filter stages that are applied in a row, see FusedFilter.
+template<typename... Stages> struct FilterStages {
+  bool apply(float &value) { return true; }
+  uint32_t expected_interval(uint32_t input) const { return input; }
+};
+
+template<typename Stage, typename... Rest> struct FilterStages<Stage, Rest...> {
+  explicit FilterStages(Stage stage, Rest... rest) : stage(stage), rest(rest...) {}
+  bool apply(float &value) { return this->stage.apply(value) && this->rest.apply(value); }
+  uint32_t expected_interval(uint32_t input) const {
+    return this->rest.expected_interval(this->stage.expected_interval(input));
+  }
+
+  Stage stage;
+  FilterStages<Rest...> rest;
+};
+
+/** Several filters of a chain fused into a single filter.
+ *
+ * Instead of one heap allocated Filter per step that calls the next one through a virtual call, the stages are
+ * stored inline and applied with calls the compiler can inline. The code generator fuses consecutive filters of a
+ * sensor's chain that have a stage (offset, multiply, calibrate_linear, delta, throttle and
+ * exponential_moving_average), other filters like lambdas stay separate nodes of the chain.
+ *
+ * ```cpp
+ * new FusedFilter<OffsetStage, DeltaStage>(OffsetStage(-2.0f), DeltaStage(0.5f));
+ * ```
+ */
+template<typename... Stages> class FusedFilter : public Filter {
+ public:
+  explicit FusedFilter(Stages... stages) : stages_(stages...) {}
+
+  optional<float> new_value(float value) override {
+    if (!this->stages_.apply(value))
+      return {};
+    return value;
+  }
+
+  uint32_t expected_interval(uint32_t input) override { return this->stages_.expected_interval(input); }
+
+ protected:
+  FilterStages<Stages...> stages_;
+};
+
 }  // namespace sensor
 }  // namespace esphome
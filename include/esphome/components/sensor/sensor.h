@@ -123,9 +123,9 @@ class Sensor : public Nameable {
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Add a callback that will be called every time a filtered value arrives.
-  void add_on_state_callback(std::function<void(float)> &&callback);
+  void add_on_state_callback(InlineFunction<void(float)> &&callback);
   /// Add a callback that will be called every time the sensor sends a raw value.
-  void add_on_raw_state_callback(std::function<void(float)> &&callback);
+  void add_on_raw_state_callback(InlineFunction<void(float)> &&callback);
 
   /** This member variable stores the last state that has passed through all filters.
    *
@@ -9,14 +9,15 @@ namespace spi {
 static const char *const TAG = "spi";
 
 void ICACHE_RAM_ATTR HOT SPIComponent::disable() {
-  if (this->hw_spi_ != nullptr) {
-    this->hw_spi_->endTransaction();
-  }
+  // Release the chip before the transaction, on the ESP32 the transaction locks the bus for other tasks
   if (this->active_cs_) {
     ESP_LOGVV(TAG, "Disabling SPI Chip on pin %u...", this->active_cs_->get_pin());
     this->active_cs_->digital_write(true);
     this->active_cs_ = nullptr;
   }
+  if (this->hw_spi_ != nullptr) {
+    this->hw_spi_->endTransaction();
+  }
 }
 void SPIComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up SPI bus...");
@@ -190,6 +190,9 @@ class SPIComponent : public Component {
 
   void disable();
 
+  /// Whether the bus uses the SPI peripheral. Only then it can be shared with other tasks.
+  bool is_hardware() const { return this->hw_spi_ != nullptr; }
+
   float get_setup_priority() const override;
 
  protected:
@@ -125,8 +125,8 @@ bool SSD1306::is_sh1106_() const {
          this->model_ == SH1106_MODEL_128_64;
 }
 void SSD1306::update() {
-  this->do_update_();
-  this->display();
+  if (this->do_update_())
+    this->display();
 }
 void SSD1306::set_brightness(float brightness) {
   // validation
@@ -194,7 +194,27 @@ void HOT SSD1306::draw_absolute_pixel_internal(int x, int y, Color color) {
     this->buffer_[pos] &= ~(1 << subpos);
   }
 }
-void SSD1306::fill(Color color) {
+void HOT SSD1306::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  const bool on = color.is_on();
+  // Each byte holds a column of 8 rows (a page), update the bits of the rows inside the rectangle at once
+  for (int page_y = y & ~0x07; page_y < y + height; page_y += 8) {
+    uint8_t mask = 0xFF;
+    if (page_y < y)
+      mask &= uint8_t(0xFF << (y - page_y));
+    if (page_y + 8 > y + height)
+      mask &= uint8_t(0xFF >> (page_y + 8 - y - height));
+
+    uint8_t *ptr = this->buffer_ + x + (page_y / 8) * this->get_width_internal();
+    for (int i = 0; i < width; i++) {
+      if (on) {
+        ptr[i] |= mask;
+      } else {
+        ptr[i] &= ~mask;
+      }
+    }
+  }
+}
+void SSD1306::fill_buffer_internal(Color color) {
   uint8_t fill = color.is_on() ? 0xFF : 0x00;
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
     this->buffer_[i] = fill;
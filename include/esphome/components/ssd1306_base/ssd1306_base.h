@@ -35,7 +35,7 @@ class SSD1306 : public PollingComponent, public display::DisplayBuffer {
   void turn_on();
   void turn_off();
   float get_setup_priority() const override { return setup_priority::PROCESSOR; }
-  void fill(Color color) override;
+  void fill_buffer_internal(Color color) override;
 
  protected:
   virtual void command(uint8_t value) = 0;
@@ -45,6 +45,7 @@ class SSD1306 : public PollingComponent, public display::DisplayBuffer {
   bool is_sh1106_() const;
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rect_internal(int x, int y, int width, int height, Color color) override;
 
   int get_height_internal() override;
   int get_width_internal() override;
@@ -122,8 +122,8 @@ void SSD1322::display() {
   this->write_display_data();
 }
 void SSD1322::update() {
-  this->do_update_();
-  this->display();
+  if (this->do_update_())
+    this->display();
 }
 void SSD1322::set_brightness(float brightness) {
   this->brightness_ = clamp(brightness, 0, 1);
@@ -173,7 +173,7 @@ void HOT SSD1322::draw_absolute_pixel_internal(int x, int y, Color color) {
   // ...then lay the new nibble back on top. done!
   this->buffer_[pos] |= color4;
 }
-void SSD1322::fill(Color color) {
+void SSD1322::fill_buffer_internal(Color color) {
   const uint32_t color4 = display::ColorUtil::color_to_grayscale4(color);
   uint8_t fill = (color4 & SSD1322_COLORMASK) | ((color4 & SSD1322_COLORMASK) << SSD1322_COLORSHIFT);
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
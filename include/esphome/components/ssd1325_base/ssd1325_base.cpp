@@ -132,8 +132,8 @@ void SSD1325::display() {
   this->write_display_data();
 }
 void SSD1325::update() {
-  this->do_update_();
-  this->display();
+  if (this->do_update_())
+    this->display();
 }
 void SSD1325::set_brightness(float brightness) {
   // validation
@@ -203,7 +203,7 @@ void HOT SSD1325::draw_absolute_pixel_internal(int x, int y, Color color) {
   // ...then lay the new nibble back on top. done!
   this->buffer_[pos] |= color4;
 }
-void SSD1325::fill(Color color) {
+void SSD1325::fill_buffer_internal(Color color) {
   const uint32_t color4 = display::ColorUtil::color_to_grayscale4(color);
   uint8_t fill = (color4 & SSD1325_COLORMASK) | ((color4 & SSD1325_COLORMASK) << SSD1325_COLORSHIFT);
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
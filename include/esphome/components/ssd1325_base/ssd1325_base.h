@@ -33,7 +33,7 @@ class SSD1325 : public PollingComponent, public display::DisplayBuffer {
   void turn_off();
 
   float get_setup_priority() const override { return setup_priority::PROCESSOR; }
-  void fill(Color color) override;
+  void fill_buffer_internal(Color color) override;
 
  protected:
   virtual void command(uint8_t value) = 0;
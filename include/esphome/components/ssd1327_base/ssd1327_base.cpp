@@ -94,8 +94,8 @@ void SSD1327::display() {
 }
 void SSD1327::update() {
   if (!this->is_failed()) {
-    this->do_update_();
-    this->display();
+    if (this->do_update_())
+      this->display();
   }
 }
 void SSD1327::set_brightness(float brightness) {
@@ -147,7 +147,7 @@ void HOT SSD1327::draw_absolute_pixel_internal(int x, int y, Color color) {
   // ...then lay the new nibble back on top. done!
   this->buffer_[pos] |= color4;
 }
-void SSD1327::fill(Color color) {
+void SSD1327::fill_buffer_internal(Color color) {
   const uint32_t color4 = display::ColorUtil::color_to_grayscale4(color);
   uint8_t fill = (color4 & SSD1327_COLORMASK) | ((color4 & SSD1327_COLORMASK) << SSD1327_COLORSHIFT);
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
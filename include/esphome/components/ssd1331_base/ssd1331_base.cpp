@@ -92,8 +92,8 @@ void SSD1331::display() {
   this->write_display_data();
 }
 void SSD1331::update() {
-  this->do_update_();
-  this->display();
+  if (this->do_update_())
+    this->display();
 }
 void SSD1331::set_brightness(float brightness) {
   // validation
@@ -129,7 +129,7 @@ void HOT SSD1331::draw_absolute_pixel_internal(int x, int y, Color color) {
   this->buffer_[pos++] = (color565 >> 8) & 0xff;
   this->buffer_[pos] = color565 & 0xff;
 }
-void SSD1331::fill(Color color) {
+void SSD1331::fill_buffer_internal(Color color) {
   const uint32_t color565 = display::ColorUtil::color_to_565(color);
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
     if (i & 1) {
@@ -102,8 +102,8 @@ void SSD1351::display() {
   this->write_display_data();
 }
 void SSD1351::update() {
-  this->do_update_();
-  this->display();
+  if (this->do_update_())
+    this->display();
 }
 void SSD1351::set_brightness(float brightness) {
   // validation
@@ -157,7 +157,7 @@ void HOT SSD1351::draw_absolute_pixel_internal(int x, int y, Color color) {
   this->buffer_[pos++] = (color565 >> 8) & 0xff;
   this->buffer_[pos] = color565 & 0xff;
 }
-void SSD1351::fill(Color color) {
+void SSD1351::fill_buffer_internal(Color color) {
   const uint32_t color565 = display::ColorUtil::color_to_565(color);
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
     if (i & 1) {
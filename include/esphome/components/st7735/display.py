@@ -23,6 +23,7 @@ CONF_ROW_START = "row_start"
 CONF_COL_START = "col_start"
 CONF_EIGHT_BIT_COLOR = "eight_bit_color"
 CONF_USE_BGR = "use_bgr"
+CONF_ASYNC_FLUSH = "async_flush"
 
 SPIST7735 = st7735_ns.class_(
     "ST7735", cg.PollingComponent, display.DisplayBuffer, spi.SPIDevice
@@ -58,6 +59,9 @@ CONFIG_SCHEMA = cv.All(
             cv.Required(CONF_ROW_START): cv.int_,
             cv.Optional(CONF_EIGHT_BIT_COLOR, default=False): cv.boolean,
             cv.Optional(CONF_USE_BGR, default=False): cv.boolean,
+            cv.Optional(CONF_ASYNC_FLUSH, default=False): cv.All(
+                cv.boolean, cv.only_on_esp32
+            ),
         }
     )
     .extend(cv.COMPONENT_SCHEMA)
@@ -96,3 +100,5 @@ async def to_code(config):
 
     dc = await cg.gpio_pin_expression(config[CONF_DC_PIN])
     cg.add(var.set_dc_pin(dc))
+    if config[CONF_ASYNC_FLUSH]:
+        cg.add(var.set_async_flush(True))
@@ -1,6 +1,7 @@
 #include "st7735.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include <new>
 
 namespace esphome {
 namespace st7735 {
@@ -285,11 +286,62 @@ void ST7735::setup() {
 
   this->init_internal_(this->get_buffer_length());
   memset(this->buffer_, 0x00, this->get_buffer_length());
+  this->enable_dirty_tracking_();
+  this->setup_flush_task_();
+}
+
+void ST7735::setup_flush_task_() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (!this->async_flush_)
+    return;
+  if (!this->parent_->is_hardware()) {
+    ESP_LOGW(TAG, "Async flush needs a hardware SPI bus, sending frames synchronously");
+    return;
+  }
+  this->flush_buffer_ = new (std::nothrow) uint8_t[this->get_buffer_length()];
+  if (this->flush_buffer_ == nullptr) {
+    ESP_LOGW(TAG, "Could not allocate the flush buffer, sending frames synchronously");
+    return;
+  }
+  auto *flush_task = new display::FlushTask();
+  if (!flush_task->start("st7735_flush",
+                         [this]() { this->write_display_data_(this->flush_buffer_, this->flush_region_); })) {
+    ESP_LOGW(TAG, "Could not start the flush task, sending frames synchronously");
+    delete flush_task;
+    delete[] this->flush_buffer_;
+    this->flush_buffer_ = nullptr;
+    return;
+  }
+  this->flush_task_ = flush_task;
+#endif
 }
 
 void ST7735::update() {
   this->do_update_();
-  this->write_display_data_();
+  if (this->dirty_.empty())
+    return;
+
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->flush_task_ != nullptr) {
+    // The previous frame must have been sent before its copy is overwritten
+    this->flush_task_->wait();
+    const int bytes_per_pixel = this->eightbitcolor_ ? 1 : 2;
+    for (const auto &rect : this->dirty_) {
+      for (int row = rect.y1; row < rect.y2; row++) {
+        const uint32_t pos = (row * this->get_width_internal() + rect.x1) * bytes_per_pixel;
+        memcpy(this->flush_buffer_ + pos, this->buffer_ + pos, rect.width() * bytes_per_pixel);
+      }
+    }
+    this->flush_region_ = this->dirty_;
+    this->dirty_.clear();
+    this->flush_task_->flush();
+    this->flush_task_->report_stats(TAG);
+    return;
+  }
+#endif
+
+  this->write_display_data_(this->buffer_, this->dirty_);
+  this->dirty_.clear();
 }
 
 int ST7735::get_height_internal() { return height_; }
@@ -318,6 +370,44 @@ void HOT ST7735::draw_absolute_pixel_internal(int x, int y, Color color) {
     this->buffer_[pos] = color565 & 0xff;
   }
 }
+void HOT ST7735::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  if (this->eightbitcolor_) {
+    const uint8_t color332 = display::ColorUtil::color_to_332(color);
+    for (int row = y; row < y + height; row++)
+      memset(this->buffer_ + x + row * this->get_width_internal(), color332, width);
+    return;
+  }
+
+  const uint32_t color565 = display::ColorUtil::color_to_565(color);
+  const uint8_t high = (color565 >> 8) & 0xff;
+  const uint8_t low = color565 & 0xff;
+  for (int row = y; row < y + height; row++) {
+    uint8_t *ptr = this->buffer_ + (x + row * this->get_width_internal()) * 2;
+    if (high == low) {
+      memset(ptr, high, width * 2);
+      continue;
+    }
+    for (int i = 0; i < width; i++) {
+      *ptr++ = high;
+      *ptr++ = low;
+    }
+  }
+}
+void HOT ST7735::draw_absolute_row_internal(int x, int y, int width, const Color *colors) {
+  if (this->eightbitcolor_) {
+    uint8_t *ptr = this->buffer_ + x + y * this->get_width_internal();
+    for (int i = 0; i < width; i++)
+      *ptr++ = display::ColorUtil::color_to_332(colors[i]);
+    return;
+  }
+
+  uint8_t *ptr = this->buffer_ + (x + y * this->get_width_internal()) * 2;
+  for (int i = 0; i < width; i++) {
+    const uint32_t color565 = display::ColorUtil::color_to_565(colors[i]);
+    *ptr++ = (color565 >> 8) & 0xff;
+    *ptr++ = color565 & 0xff;
+  }
+}
 
 void ST7735::init_reset_() {
   if (this->reset_pin_ != nullptr) {
@@ -379,6 +469,9 @@ void ST7735::dump_config() {
   ESP_LOGD(TAG, "  Width: %d", this->width_);
   ESP_LOGD(TAG, "  ColStart: %d", this->colstart_);
   ESP_LOGD(TAG, "  RowStart: %d", this->rowstart_);
+#ifdef ARDUINO_ARCH_ESP32
+  ESP_LOGCONFIG(TAG, "  Async Flush: %s", YESNO(this->flush_task_ != nullptr));
+#endif
   LOG_UPDATE_INTERVAL(this);
 }
 
@@ -413,48 +506,54 @@ void HOT ST7735::senddata_(const uint8_t *data_bytes, uint8_t num_data_bytes) {
   this->disable();
 }
 
-void HOT ST7735::write_display_data_() {
-  uint16_t offsetx = colstart_;
-  uint16_t offsety = rowstart_;
-
-  uint16_t x1 = offsetx;
-  uint16_t x2 = x1 + get_width_internal() - 1;
-  uint16_t y1 = offsety;
-  uint16_t y2 = y1 + get_height_internal() - 1;
-
-  this->enable();
-
+void ST7735::set_addr_window_(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
   // set column(x) address
   this->dc_pin_->digital_write(false);
   this->write_byte(ST77XX_CASET);
   this->dc_pin_->digital_write(true);
-  this->spi_master_write_addr_(x1, x2);
+  this->spi_master_write_addr_(x + this->colstart_, x + this->colstart_ + w - 1);
 
   // set Page(y) address
   this->dc_pin_->digital_write(false);
   this->write_byte(ST77XX_RASET);
   this->dc_pin_->digital_write(true);
-  this->spi_master_write_addr_(y1, y2);
+  this->spi_master_write_addr_(y + this->rowstart_, y + this->rowstart_ + h - 1);
 
   //  Memory Write
   this->dc_pin_->digital_write(false);
   this->write_byte(ST77XX_RAMWR);
   this->dc_pin_->digital_write(true);
+}
 
-  if (this->eightbitcolor_) {
-    for (int line = 0; line < this->get_buffer_length(); line = line + this->get_width_internal()) {
-      for (int index = 0; index < this->get_width_internal(); ++index) {
-        auto color332 = display::ColorUtil::to_color(this->buffer_[index + line], display::ColorOrder::COLOR_ORDER_RGB,
-                                                     display::ColorBitness::COLOR_BITNESS_332, true);
-
-        auto color = display::ColorUtil::color_to_565(color332);
+void HOT ST7735::write_display_data_(const uint8_t *buffer, const display::DirtyRegion &region) {
+  this->enable();
 
-        this->write_byte((color >> 8) & 0xff);
-        this->write_byte(color & 0xff);
+  // only the changed regions are written
+  uint8_t chunk[2 * 64];
+  for (const auto &rect : region) {
+    this->set_addr_window_(rect.x1, rect.y1, rect.width(), rect.height());
+    for (int row = rect.y1; row < rect.y2; row++) {
+      const uint32_t line = row * this->get_width_internal();
+      if (this->eightbitcolor_) {
+        // convert up to 64 pixels at a time and send them in one go
+        for (int index = rect.x1; index < rect.x2;) {
+          uint8_t *dst = chunk;
+          const int end = std::min<int>(rect.x2, index + 64);
+          for (; index < end; ++index) {
+            auto color332 = display::ColorUtil::to_color(buffer[index + line], display::ColorOrder::COLOR_ORDER_RGB,
+                                                         display::ColorBitness::COLOR_BITNESS_332, true);
+
+            auto color = display::ColorUtil::color_to_565(color332);
+
+            *dst++ = (color >> 8) & 0xff;
+            *dst++ = color & 0xff;
+          }
+          this->write_array(chunk, dst - chunk);
+        }
+      } else {
+        this->write_array(buffer + (line + rect.x1) * 2, rect.width() * 2);
       }
     }
-  } else {
-    this->write_array(this->buffer_, this->get_buffer_length());
   }
   this->disable();
 }
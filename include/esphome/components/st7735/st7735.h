@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/components/spi/spi.h"
 #include "esphome/components/display/display_buffer.h"
+#include "esphome/components/display/flush_task.h"
 
 namespace esphome {
 namespace st7735 {
@@ -50,6 +51,16 @@ class ST7735 : public PollingComponent,
 
   void set_reset_pin(GPIOPin *value) { this->reset_pin_ = value; }
   void set_dc_pin(GPIOPin *value) { dc_pin_ = value; }
+  /// Send the frames to the display in a background task while the next frame is drawn (ESP32 only).
+  void set_async_flush(bool async_flush) { this->async_flush_ = async_flush; }
+#ifdef ARDUINO_ARCH_ESP32
+  /// Duration of the last background flush in microseconds, 0 if frames are sent synchronously.
+  uint32_t get_flush_time() const { return this->flush_task_ != nullptr ? this->flush_task_->get_flush_time() : 0; }
+  /// How long the last background flush ran in parallel to the loop, in microseconds.
+  uint32_t get_flush_overlap_time() const {
+    return this->flush_task_ != nullptr ? this->flush_task_->get_overlap_time() : 0;
+  }
+#endif
   size_t get_buffer_length();
 
  protected:
@@ -59,12 +70,16 @@ class ST7735 : public PollingComponent,
   void writecommand_(uint8_t value);
   void writedata_(uint8_t value);
 
-  void write_display_data_();
+  void setup_flush_task_();
+  /// Send the regions of the buffer to the display.
+  void write_display_data_(const uint8_t *buffer, const display::DirtyRegion &region);
 
   void init_reset_();
   void display_init_(const uint8_t *addr);
   void set_addr_window_(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rect_internal(int x, int y, int width, int height, Color color) override;
+  void draw_absolute_row_internal(int x, int y, int width, const Color *colors) override;
   void spi_master_write_addr_(uint16_t addr1, uint16_t addr2);
   void spi_master_write_color_(uint16_t color, uint16_t size);
 
@@ -81,6 +96,14 @@ class ST7735 : public PollingComponent,
 
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *dc_pin_{nullptr};
+
+  bool async_flush_{false};
+#ifdef ARDUINO_ARCH_ESP32
+  display::FlushTask *flush_task_{nullptr};
+  /// The copy of the buffer that's sent by the flush task, and the regions it sends.
+  uint8_t *flush_buffer_{nullptr};
+  display::DirtyRegion flush_region_;
+#endif
 };
 
 }  // namespace st7735
@@ -127,8 +127,8 @@ void ST7789V::dump_config() {
 float ST7789V::get_setup_priority() const { return setup_priority::PROCESSOR; }
 
 void ST7789V::update() {
-  this->do_update_();
-  this->write_display_data();
+  if (this->do_update_())
+    this->write_display_data();
 }
 
 void ST7789V::loop() {}
@@ -80,7 +80,7 @@ class Switch : public Nameable {
    *
    * @param callback The void(bool) callback.
    */
-  void add_on_state_callback(std::function<void(bool)> &&callback);
+  void add_on_state_callback(InlineFunction<void(bool)> &&callback);
 
   optional<bool> get_initial_state();
 
@@ -26,7 +26,7 @@ class TextSensor : public Nameable {
 
   void set_icon(const std::string &icon);
 
-  void add_on_state_callback(std::function<void(std::string)> callback);
+  void add_on_state_callback(InlineFunction<void(std::string)> &&callback);
 
   std::string state;
 
@@ -124,10 +124,10 @@ bool WaveshareEPaper::wait_until_idle_() {
   return true;
 }
 void WaveshareEPaper::update() {
-  this->do_update_();
-  this->display();
+  if (this->do_update_())
+    this->display();
 }
-void WaveshareEPaper::fill(Color color) {
+void WaveshareEPaper::fill_buffer_internal(Color color) {
   // flip logic
   const uint8_t fill = color.is_on() ? 0x00 : 0xFF;
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
@@ -145,6 +145,40 @@ void HOT WaveshareEPaper::draw_absolute_pixel_internal(int x, int y, Color color
   else
     this->buffer_[pos] &= ~(0x80 >> subpos);
 }
+void HOT WaveshareEPaper::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  const int display_width = this->get_width_internal();
+  if (display_width % 8 != 0) {
+    // rows don't start at a byte boundary
+    DisplayBuffer::fill_absolute_rect_internal(x, y, width, height, color);
+    return;
+  }
+
+  // flip logic
+  const bool set = !color.is_on();
+  const int first = x / 8;
+  const int last = (x + width - 1) / 8;
+  uint8_t first_mask = 0xFF >> (x & 0x07);
+  const uint8_t last_mask = 0xFF << (7 - ((x + width - 1) & 0x07));
+  if (first == last)
+    first_mask &= last_mask;
+
+  for (int row = y; row < y + height; row++) {
+    uint8_t *line = this->buffer_ + row * (display_width / 8);
+    if (set) {
+      line[first] |= first_mask;
+    } else {
+      line[first] &= ~first_mask;
+    }
+    if (first == last)
+      continue;
+    memset(line + first + 1, set ? 0xFF : 0x00, last - first - 1);
+    if (set) {
+      line[last] |= last_mask;
+    } else {
+      line[last] &= ~last_mask;
+    }
+  }
+}
 uint32_t WaveshareEPaper::get_buffer_length_() { return this->get_width_internal() * this->get_height_internal() / 8u; }
 void WaveshareEPaper::start_command_() {
   this->dc_pin_->digital_write(false);
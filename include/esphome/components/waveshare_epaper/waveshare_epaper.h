@@ -26,7 +26,7 @@ class WaveshareEPaper : public PollingComponent,
 
   void update() override;
 
-  void fill(Color color) override;
+  void fill_buffer_internal(Color color) override;
 
   void setup() override {
     this->setup_pins_();
@@ -37,6 +37,7 @@ class WaveshareEPaper : public PollingComponent,
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rect_internal(int x, int y, int width, int height, Color color) override;
 
   bool wait_until_idle_();
 
@@ -73,73 +73,178 @@ void WebServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up web server...");
   this->setup_controller();
   this->base_->init();
+#ifdef ARDUINO_ARCH_ESP32
+  this->cache_lock_ = xSemaphoreCreateMutex();
+#endif
 
   this->events_.onConnect([this](AsyncEventSourceClient *client) {
     // Configure reconnect timeout
     client->send("", "ping", millis(), 30000);
+    // The client is only valid in this callback, it's deleted when it disconnects
+    this->send_initial_state_(client);
+  });
+
+#ifdef USE_LOGGER
+  if (logger::global_logger != nullptr)
+    logger::global_logger->add_on_log_callback(
+        [this](int level, const char *tag, const char *message) { this->events_.send(message, "log", millis()); });
+#endif
+  this->base_->add_handler(&this->events_);
+  this->base_->add_handler(this);
+  this->base_->add_ota_handler();
 
+  this->set_interval(10000, [this]() { this->events_.send("", "ping", millis(), 30000); });
+}
+void WebServer::loop() {
+  if (!this->missing_states_pending_)
+    return;
+  this->missing_states_pending_ = false;
+  this->publish_missing_states_();
+}
+bool WebServer::can_loop_tickless() const { return true; }
+void WebServer::dump_config() {
+  ESP_LOGCONFIG(TAG, "Web Server:");
+  ESP_LOGCONFIG(TAG, "  Address: %s:%u", network_get_address().c_str(), this->base_->get_port());
+  if (this->using_auth()) {
+    ESP_LOGCONFIG(TAG, "  Basic authentication enabled");
+  }
+}
+float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f; }
+
+void WebServer::lock_cache_() {
+#ifdef ARDUINO_ARCH_ESP32
+  xSemaphoreTake(this->cache_lock_, portMAX_DELAY);
+#endif
+}
+void WebServer::unlock_cache_() {
+#ifdef ARDUINO_ARCH_ESP32
+  xSemaphoreGive(this->cache_lock_);
+#endif
+}
+void WebServer::publish_state_json_(Nameable *obj, const std::function<std::string()> &build) {
+  if (this->events_.count() == 0) {
+    // Nobody is listening, serialize when the next client connects
+    this->lock_cache_();
+    this->state_json_cache_[obj].clear();
+    this->unlock_cache_();
+    // a client that connected in the meantime may have received the old state
+    if (this->events_.count() == 0)
+      return;
+  }
+  std::string json = build();
+  // cached before it's sent, so a client that connects in between receives it at least once
+  this->lock_cache_();
+  this->state_json_cache_[obj] = json;
+  this->unlock_cache_();
+  this->events_.send(json.c_str(), "state");
+}
+void WebServer::publish_missing_state_json_(Nameable *obj, const std::function<std::string()> &build) {
+  this->lock_cache_();
+  bool missing = this->state_json_cache_[obj].empty();
+  this->unlock_cache_();
+  // none of the clients has this state yet, so it's sent to all of them
+  if (missing)
+    this->publish_state_json_(obj, build);
+}
+void WebServer::publish_missing_states_() {
 #ifdef USE_SENSOR
-    for (auto *obj : App.get_sensors())
-      if (!obj->is_internal())
-        client->send(this->sensor_json(obj, obj->state).c_str(), "state");
+  for (auto *obj : App.get_sensors())
+    if (!obj->is_internal())
+      this->publish_missing_state_json_(obj, [this, obj]() { return this->sensor_json(obj, obj->state); });
 #endif
 
 #ifdef USE_SWITCH
-    for (auto *obj : App.get_switches())
-      if (!obj->is_internal())
-        client->send(this->switch_json(obj, obj->state).c_str(), "state");
+  for (auto *obj : App.get_switches())
+    if (!obj->is_internal())
+      this->publish_missing_state_json_(obj, [this, obj]() { return this->switch_json(obj, obj->state); });
 #endif
 
 #ifdef USE_BINARY_SENSOR
-    for (auto *obj : App.get_binary_sensors())
-      if (!obj->is_internal())
-        client->send(this->binary_sensor_json(obj, obj->state).c_str(), "state");
+  for (auto *obj : App.get_binary_sensors())
+    if (!obj->is_internal())
+      this->publish_missing_state_json_(obj, [this, obj]() { return this->binary_sensor_json(obj, obj->state); });
 #endif
 
 #ifdef USE_FAN
-    for (auto *obj : App.get_fans())
-      if (!obj->is_internal())
-        client->send(this->fan_json(obj).c_str(), "state");
+  for (auto *obj : App.get_fans())
+    if (!obj->is_internal())
+      this->publish_missing_state_json_(obj, [this, obj]() { return this->fan_json(obj); });
 #endif
 
 #ifdef USE_LIGHT
-    for (auto *obj : App.get_lights())
-      if (!obj->is_internal())
-        client->send(this->light_json(obj).c_str(), "state");
+  for (auto *obj : App.get_lights())
+    if (!obj->is_internal())
+      this->publish_missing_state_json_(obj, [this, obj]() { return this->light_json(obj); });
 #endif
 
 #ifdef USE_TEXT_SENSOR
-    for (auto *obj : App.get_text_sensors())
-      if (!obj->is_internal())
-        client->send(this->text_sensor_json(obj, obj->state).c_str(), "state");
+  for (auto *obj : App.get_text_sensors())
+    if (!obj->is_internal())
+      this->publish_missing_state_json_(obj, [this, obj]() { return this->text_sensor_json(obj, obj->state); });
 #endif
 
 #ifdef USE_COVER
-    for (auto *obj : App.get_covers())
-      if (!obj->is_internal())
-        client->send(this->cover_json(obj).c_str(), "state");
+  for (auto *obj : App.get_covers())
+    if (!obj->is_internal())
+      this->publish_missing_state_json_(obj, [this, obj]() { return this->cover_json(obj); });
+#endif
+}
+void WebServer::send_cached_state_(AsyncEventSourceClient *client, Nameable *obj) {
+  auto it = this->state_json_cache_.find(obj);
+  if (it == this->state_json_cache_.end() || it->second.empty()) {
+    this->missing_states_pending_ = true;
+    return;
+  }
+  client->send(it->second.c_str(), "state");
+}
+void WebServer::send_initial_state_(AsyncEventSourceClient *client) {
+  // Entity states are only read in the main loop, this sends what's cached and leaves the rest to loop()
+  this->lock_cache_();
+#ifdef USE_SENSOR
+  for (auto *obj : App.get_sensors())
+    if (!obj->is_internal())
+      this->send_cached_state_(client, obj);
 #endif
-  });
 
-#ifdef USE_LOGGER
-  if (logger::global_logger != nullptr)
-    logger::global_logger->add_on_log_callback(
-        [this](int level, const char *tag, const char *message) { this->events_.send(message, "log", millis()); });
+#ifdef USE_SWITCH
+  for (auto *obj : App.get_switches())
+    if (!obj->is_internal())
+      this->send_cached_state_(client, obj);
 #endif
-  this->base_->add_handler(&this->events_);
-  this->base_->add_handler(this);
-  this->base_->add_ota_handler();
 
-  this->set_interval(10000, [this]() { this->events_.send("", "ping", millis(), 30000); });
-}
-void WebServer::dump_config() {
-  ESP_LOGCONFIG(TAG, "Web Server:");
-  ESP_LOGCONFIG(TAG, "  Address: %s:%u", network_get_address().c_str(), this->base_->get_port());
-  if (this->using_auth()) {
-    ESP_LOGCONFIG(TAG, "  Basic authentication enabled");
-  }
+#ifdef USE_BINARY_SENSOR
+  for (auto *obj : App.get_binary_sensors())
+    if (!obj->is_internal())
+      this->send_cached_state_(client, obj);
+#endif
+
+#ifdef USE_FAN
+  for (auto *obj : App.get_fans())
+    if (!obj->is_internal())
+      this->send_cached_state_(client, obj);
+#endif
+
+#ifdef USE_LIGHT
+  for (auto *obj : App.get_lights())
+    if (!obj->is_internal())
+      this->send_cached_state_(client, obj);
+#endif
+
+#ifdef USE_TEXT_SENSOR
+  for (auto *obj : App.get_text_sensors())
+    if (!obj->is_internal())
+      this->send_cached_state_(client, obj);
+#endif
+
+#ifdef USE_COVER
+  for (auto *obj : App.get_covers())
+    if (!obj->is_internal())
+      this->send_cached_state_(client, obj);
+#endif
+  this->unlock_cache_();
+  if (this->missing_states_pending_)
+    App.wake_loop();
 }
-float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f; }
 
 void WebServer::handle_index_request(AsyncWebServerRequest *request) {
   AsyncResponseStream *stream = request->beginResponseStream("text/html");
@@ -240,7 +345,7 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  this->events_.send(this->sensor_json(obj, state).c_str(), "state");
+  this->publish_state_json_(obj, [this, obj, state]() { return this->sensor_json(obj, state); });
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (sensor::Sensor *obj : App.get_sensors()) {
@@ -255,20 +360,22 @@ void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "sensor-" + obj->get_object_id();
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.begin_object();
+    root.member("id", "sensor-" + obj->get_object_id());
     std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
     if (!obj->get_unit_of_measurement().empty())
       state += " " + obj->get_unit_of_measurement();
-    root["state"] = state;
-    root["value"] = value;
+    root.member("state", state);
+    root.member("value", value);
+    root.end_object();
   });
 }
 #endif
 
 #ifdef USE_TEXT_SENSOR
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
-  this->events_.send(this->text_sensor_json(obj, state).c_str(), "state");
+  this->publish_state_json_(obj, [this, obj, state]() { return this->text_sensor_json(obj, state); });
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
@@ -283,23 +390,27 @@ void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const
   request->send(404);
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "text_sensor-" + obj->get_object_id();
-    root["state"] = value;
-    root["value"] = value;
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.begin_object();
+    root.member("id", "text_sensor-" + obj->get_object_id());
+    root.member("state", value);
+    root.member("value", value);
+    root.end_object();
   });
 }
 #endif
 
 #ifdef USE_SWITCH
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
-  this->events_.send(this->switch_json(obj, state).c_str(), "state");
+  this->publish_state_json_(obj, [this, obj, state]() { return this->switch_json(obj, state); });
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "switch-" + obj->get_object_id();
-    root["state"] = value ? "ON" : "OFF";
-    root["value"] = value;
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.begin_object();
+    root.member("id", "switch-" + obj->get_object_id());
+    root.member("state", value ? "ON" : "OFF");
+    root.member("value", value);
+    root.end_object();
   });
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -334,13 +445,15 @@ void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlM
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
   if (obj->is_internal())
     return;
-  this->events_.send(this->binary_sensor_json(obj, state).c_str(), "state");
+  this->publish_state_json_(obj, [this, obj, state]() { return this->binary_sensor_json(obj, state); });
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "binary_sensor-" + obj->get_object_id();
-    root["state"] = value ? "ON" : "OFF";
-    root["value"] = value;
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.begin_object();
+    root.member("id", "binary_sensor-" + obj->get_object_id());
+    root.member("state", value ? "ON" : "OFF");
+    root.member("value", value);
+    root.end_object();
   });
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -361,30 +474,32 @@ void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, con
 void WebServer::on_fan_update(fan::FanState *obj) {
   if (obj->is_internal())
     return;
-  this->events_.send(this->fan_json(obj).c_str(), "state");
+  this->publish_state_json_(obj, [this, obj]() { return this->fan_json(obj); });
 }
 std::string WebServer::fan_json(fan::FanState *obj) {
-  return json::build_json([obj](JsonObject &root) {
-    root["id"] = "fan-" + obj->get_object_id();
-    root["state"] = obj->state ? "ON" : "OFF";
-    root["value"] = obj->state;
+  return json::write_json([obj](json::JsonWriter &root) {
+    root.begin_object();
+    root.member("id", "fan-" + obj->get_object_id());
+    root.member("state", obj->state ? "ON" : "OFF");
+    root.member("value", obj->state);
     const auto traits = obj->get_traits();
     if (traits.supports_speed()) {
-      root["speed_level"] = obj->speed;
+      root.member("speed_level", obj->speed);
       switch (fan::speed_level_to_enum(obj->speed, traits.supported_speed_count())) {
         case fan::FAN_SPEED_LOW:
-          root["speed"] = "low";
+          root.member("speed", "low");
           break;
         case fan::FAN_SPEED_MEDIUM:
-          root["speed"] = "medium";
+          root.member("speed", "medium");
           break;
         case fan::FAN_SPEED_HIGH:
-          root["speed"] = "high";
+          root.member("speed", "high");
           break;
       }
     }
     if (obj->get_traits().supports_oscillation())
-      root["oscillation"] = obj->oscillating;
+      root.member("oscillation", obj->oscillating);
+    root.end_object();
   });
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -451,7 +566,7 @@ void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatc
 void WebServer::on_light_update(light::LightState *obj) {
   if (obj->is_internal())
     return;
-  this->events_.send(this->light_json(obj).c_str(), "state");
+  this->publish_state_json_(obj, [this, obj]() { return this->light_json(obj); });
 }
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (light::LightState *obj : App.get_lights()) {
@@ -526,7 +641,7 @@ std::string WebServer::light_json(light::LightState *obj) {
 void WebServer::on_cover_update(cover::Cover *obj) {
   if (obj->is_internal())
     return;
-  this->events_.send(this->cover_json(obj).c_str(), "state");
+  this->publish_state_json_(obj, [this, obj]() { return this->cover_json(obj); });
 }
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (cover::Cover *obj : App.get_covers()) {
@@ -572,14 +687,16 @@ void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMa
   request->send(404);
 }
 std::string WebServer::cover_json(cover::Cover *obj) {
-  return json::build_json([obj](JsonObject &root) {
-    root["id"] = "cover-" + obj->get_object_id();
-    root["state"] = obj->is_fully_closed() ? "CLOSED" : "OPEN";
-    root["value"] = obj->position;
-    root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
+  return json::write_json([obj](json::JsonWriter &root) {
+    root.begin_object();
+    root.member("id", "cover-" + obj->get_object_id());
+    root.member("state", obj->is_fully_closed() ? "CLOSED" : "OPEN");
+    root.member("value", obj->position);
+    root.member("current_operation", cover::cover_operation_to_str(obj->current_operation));
 
     if (obj->get_traits().get_supports_tilt())
-      root["tilt"] = obj->tilt;
+      root.member("tilt", obj->tilt);
+    root.end_object();
   });
 }
 #endif
@@ -4,8 +4,14 @@
 #include "esphome/core/controller.h"
 #include "esphome/components/web_server_base/web_server_base.h"
 
+#include <map>
 #include <vector>
 
+#ifdef ARDUINO_ARCH_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
 namespace esphome {
 namespace web_server {
 
@@ -65,6 +71,11 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Setup the internal web server and register handlers.
   void setup() override;
 
+  /// Send the states to newly connected event source clients.
+  void loop() override;
+
+  bool can_loop_tickless() const override;
+
   void dump_config() override;
 
   /// MQTT setup priority.
@@ -162,6 +173,17 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   bool isRequestHandlerTrivial() override;
 
  protected:
+  /// Send the new state of an entity to all event source clients and cache it for new clients.
+  void publish_state_json_(Nameable *obj, const std::function<std::string()> &build);
+  /// Publish the states that aren't cached, because they changed while no client was connected.
+  void publish_missing_state_json_(Nameable *obj, const std::function<std::string()> &build);
+  void publish_missing_states_();
+  /// Send the cached state of all entities to a new event source client, the missing ones are published by loop().
+  void send_initial_state_(AsyncEventSourceClient *client);
+  void send_cached_state_(AsyncEventSourceClient *client, Nameable *obj);
+  void lock_cache_();
+  void unlock_cache_();
+
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
   const char *username_{nullptr};
@@ -170,6 +192,14 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   const char *css_include_{nullptr};
   const char *js_url_{nullptr};
   const char *js_include_{nullptr};
+  /// Last JSON state of each entity, empty if it changed while no client was connected.
+  std::map<Nameable *, std::string> state_json_cache_;
+#ifdef ARDUINO_ARCH_ESP32
+  /// Guards state_json_cache_, new clients read it from the web server task.
+  SemaphoreHandle_t cache_lock_{nullptr};
+#endif
+  /// Set when a new event source client is missing states that aren't cached.
+  volatile bool missing_states_pending_{false};
 };
 
 }  // namespace web_server
@@ -212,6 +212,10 @@ void WiFiComponent::setup_ap_config_() {
 float WiFiComponent::get_loop_priority() const {
   return 10.0f;  // before other loop components
 }
+bool WiFiComponent::can_loop_tickless() const {
+  // Noticing a lost connection a second late is fine, connecting and scanning need to be polled
+  return !this->has_sta() || this->state_ == WIFI_COMPONENT_STATE_STA_CONNECTED;
+}
 void WiFiComponent::set_ap(const WiFiAP &ap) { this->ap_ = ap; }
 void WiFiComponent::add_sta(const WiFiAP &ap) { this->sta_.push_back(ap); }
 void WiFiComponent::set_sta(const WiFiAP &ap) {
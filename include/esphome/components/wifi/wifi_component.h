@@ -202,6 +202,7 @@ class WiFiComponent : public Component {
 
   /// Reconnect WiFi if required.
   void loop() override;
+  bool can_loop_tickless() const override;
 
   bool has_sta() const;
   bool has_ap() const;
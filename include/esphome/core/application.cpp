@@ -11,6 +11,9 @@ namespace esphome {
 
 static const char *const TAG = "app";
 
+/// Longest sleep of a tickless loop, so that components that poll in loop() still run once per second.
+static const uint32_t MAX_TICKLESS_SLEEP = 1000;
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -27,6 +30,9 @@ void Application::register_component_(Component *comp) {
 }
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+#ifdef ARDUINO_ARCH_ESP32
+  this->loop_task_handle_ = xTaskGetCurrentTaskHandle();
+#endif
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
@@ -75,8 +81,10 @@ void Application::loop() {
     this->feed_wdt();
   }
   this->app_state_ = new_app_state;
+  global_preferences.loop();
 
   const uint32_t end = millis();
+  this->loop_duration_ = end - start;
   if (end - start > 200) {
     ESP_LOGV(TAG, "A component took a long time in a loop() cycle (%.2f s).", (end - start) / 1e3f);
     ESP_LOGV(TAG, "Components should block for at most 20-30ms in loop().");
@@ -91,12 +99,14 @@ void Application::loop() {
     if (now - this->last_loop_ < this->loop_interval_)
       delay_time = this->loop_interval_ - (now - this->last_loop_);
 
-    uint32_t next_schedule = this->scheduler.next_schedule_in().value_or(delay_time);
+    // Without components that need polling, nothing happens before the next scheduler item or a wakeup
+    const uint32_t max_sleep = this->is_tickless_() ? MAX_TICKLESS_SLEEP : delay_time;
+    uint32_t next_schedule = this->scheduler.next_schedule_in().value_or(max_sleep);
     // next_schedule is max 0.5*delay_time
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
-    delay_time = std::min(next_schedule, delay_time);
-    delay(delay_time);
+    delay_time = std::min(next_schedule, max_sleep);
+    this->sleep_(delay_time);
   }
   this->last_loop_ = now;
 
@@ -135,6 +145,7 @@ void Application::reboot() {
   ESP_LOGI(TAG, "Forcing a reboot...");
   for (auto *comp : this->components_)
     comp->on_shutdown();
+  global_preferences.sync();
   ESP.restart();
   // restart() doesn't always end execution
   while (true) {
@@ -147,6 +158,7 @@ void Application::safe_reboot() {
     comp->on_safe_shutdown();
   for (auto *comp : this->components_)
     comp->on_shutdown();
+  global_preferences.sync();
   ESP.restart();
   // restart() doesn't always end execution
   while (true) {
@@ -160,6 +172,41 @@ void Application::calculate_looping_components_() {
       this->looping_components_.push_back(obj);
   }
 }
+bool Application::is_tickless_() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->dump_config_at_ >= 0 && this->dump_config_at_ < this->components_.size())
+    return false;
+  for (auto *component : this->looping_components_) {
+    if (!component->is_failed() && !component->can_loop_tickless())
+      return false;
+  }
+  return true;
+#else
+  // delay() can't be interrupted by a wakeup
+  return false;
+#endif
+}
+void Application::sleep_(uint32_t ms) {
+#ifdef ARDUINO_ARCH_ESP32
+  // Any wake_loop() since the last sleep is still pending as notification and ends the wait immediately
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+#else
+  if (this->wake_requested_) {
+    this->wake_requested_ = false;
+    yield();
+    return;
+  }
+  delay(ms);
+#endif
+}
+void Application::wake_loop() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->loop_task_handle_ != nullptr)
+    xTaskNotifyGive(this->loop_task_handle_);
+#else
+  this->wake_requested_ = true;
+#endif
+}
 
 Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
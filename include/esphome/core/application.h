@@ -8,6 +8,11 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/scheduler.h"
 
+#ifdef ARDUINO_ARCH_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -113,10 +118,24 @@ class Application {
    * Each component can request a high frequency loop execution by using the HighFrequencyLoopRequester
    * helper in helpers.h
    *
+   * On the ESP32, if all looping components allow it (see Component::can_loop_tickless()), the loop instead
+   * sleeps until the next timeout/interval is due or a wakeup source calls wake_loop().
+   *
    * @param loop_interval The interval in milliseconds to run the core loop at. Defaults to 16 milliseconds.
    */
   void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
 
+  /// Time the last loop() iteration took in milliseconds, without sleeping.
+  uint32_t get_loop_duration() const { return this->loop_duration_; }
+
+  /** Wake up the main loop if it's sleeping between two loop() cycles.
+   *
+   * Wakeup sources (network callbacks, other tasks) call this after handing work to a component,
+   * so that it's handled right away instead of at the end of the sleep. Only the ESP32 can cut a
+   * sleep short, on the ESP8266 this only skips the next sleep.
+   */
+  void wake_loop();
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
   void feed_wdt();
@@ -132,10 +151,13 @@ class Application {
     for (auto *comp : this->components_) {
       comp->on_shutdown();
     }
+    global_preferences.sync();
   }
 
   uint32_t get_app_state() const { return this->app_state_; }
 
+  const std::vector<Component *> &get_components() const { return this->components_; }
+
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
@@ -218,6 +240,11 @@ class Application {
 
   void calculate_looping_components_();
 
+  /// Whether the loop can sleep until the next scheduler item or wakeup, instead of waking up every loop_interval.
+  bool is_tickless_();
+
+  void sleep_(uint32_t ms);
+
   std::vector<Component *> components_{};
   std::vector<Component *> looping_components_{};
 
@@ -251,6 +278,12 @@ class Application {
   bool name_add_mac_suffix_;
   uint32_t last_loop_{0};
   uint32_t loop_interval_{16};
+  uint32_t loop_duration_{0};
+#ifdef ARDUINO_ARCH_ESP32
+  TaskHandle_t loop_task_handle_{nullptr};
+#else
+  volatile bool wake_requested_{false};
+#endif
   int dump_config_at_{-1};
   uint32_t app_state_{0};
 };
@@ -39,6 +39,7 @@ const uint32_t STATUS_LED_ERROR = 0x0200;
 uint32_t global_state = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 float Component::get_loop_priority() const { return 0.0f; }
+bool Component::can_loop_tickless() const { return false; }
 
 float Component::get_setup_priority() const { return setup_priority::DATA; }
 
@@ -62,10 +63,31 @@ bool Component::cancel_timeout(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
 }
 
+void Component::set_interval(uint32_t id, uint32_t interval, InlineFunction<void()> &&f) {  // NOLINT
+  App.scheduler.set_interval(this, id, interval, std::move(f));
+}
+
+bool Component::cancel_interval(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_interval(this, id);
+}
+
+void Component::set_timeout(uint32_t id, uint32_t timeout, InlineFunction<void()> &&f) {  // NOLINT
+  App.scheduler.set_timeout(this, id, timeout, std::move(f));
+}
+
+bool Component::cancel_timeout(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, id);
+}
+
 void Component::call_loop() { this->loop(); }
 
 void Component::call_setup() { this->setup(); }
 uint32_t Component::get_component_state() const { return this->component_state_; }
+const char *Component::get_component_source() const {
+  if (this->component_source_ == nullptr)
+    return "<unknown>";
+  return this->component_source_;
+}
 void Component::call() {
   uint32_t state = this->component_state_ & COMPONENT_STATE_MASK;
   switch (state) {
@@ -73,17 +95,32 @@ void Component::call() {
       // State Construction: Call setup and set state to setup
       this->component_state_ &= ~COMPONENT_STATE_MASK;
       this->component_state_ |= COMPONENT_STATE_SETUP;
+#ifdef USE_COMPONENT_PROFILER
+      {
+        const uint32_t start = micros();
+        this->call_setup();
+        this->runtime_stats_.setup_time_us = micros() - start;
+      }
+#else
       this->call_setup();
+#endif
       break;
     case COMPONENT_STATE_SETUP:
       // State setup: Call first loop and set state to loop
       this->component_state_ &= ~COMPONENT_STATE_MASK;
       this->component_state_ |= COMPONENT_STATE_LOOP;
-      this->call_loop();
-      break;
+      // fall through
     case COMPONENT_STATE_LOOP:
       // State loop: Call loop
+#ifdef USE_COMPONENT_PROFILER
+      {
+        const uint32_t start = micros();
+        this->call_loop();
+        this->runtime_stats_.record(micros() - start);
+      }
+#else
       this->call_loop();
+#endif
       break;
     case COMPONENT_STATE_FAILED:
       // State failed: Do nothing
@@ -99,7 +136,7 @@ void Component::mark_failed() {
   this->status_set_error();
 }
 void Component::defer(std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", 0, std::move(f));
+  App.scheduler.set_timeout(this, 0, std::move(f));
 }
 bool Component::cancel_defer(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
@@ -108,10 +145,10 @@ void Component::defer(const std::string &name, std::function<void()> &&f) {  //
   App.scheduler.set_timeout(this, name, 0, std::move(f));
 }
 void Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", timeout, std::move(f));
+  App.scheduler.set_timeout(this, timeout, std::move(f));
 }
 void Component::set_interval(uint32_t interval, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_interval(this, "", interval, std::move(f));
+  App.scheduler.set_interval(this, interval, std::move(f));
 }
 bool Component::is_failed() { return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_FAILED; }
 bool Component::can_proceed() { return true; }
@@ -157,6 +194,22 @@ bool Component::has_overridden_loop() const {
   return loop_overridden || call_loop_overridden;
 }
 
+#ifdef USE_COMPONENT_PROFILER
+void HOT ComponentRuntimeStats::record(uint32_t time_us) {
+  this->call_count++;
+  this->total_time_us += time_us;
+  if (time_us > this->max_time_us)
+    this->max_time_us = time_us;
+  const uint8_t bucket = time_us <= 1 ? 0 : 32 - __builtin_clz(time_us - 1);
+  this->histogram[std::min<uint8_t>(bucket, HISTOGRAM_BUCKETS - 1)]++;
+}
+void ComponentRuntimeStats::reset() {
+  const uint32_t setup_time_us = this->setup_time_us;
+  *this = ComponentRuntimeStats();
+  this->setup_time_us = setup_time_us;
+}
+#endif
+
 PollingComponent::PollingComponent(uint32_t update_interval) : Component(), update_interval_(update_interval) {}
 
 void PollingComponent::call_setup() {
@@ -164,7 +217,7 @@ void PollingComponent::call_setup() {
   this->setup();
 
   // Register interval.
-  this->set_interval("update", this->get_update_interval(), [this]() { this->update(); });
+  this->set_interval(const_fnv1_hash("update"), this->get_update_interval(), [this]() { this->update(); });
 }
 
 uint32_t PollingComponent::get_update_interval() const { return this->update_interval_; }
@@ -5,6 +5,8 @@
 #include "Arduino.h"
 
 #include "esphome/core/optional.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/defines.h"
 
 namespace esphome {
 
@@ -55,6 +57,25 @@ extern const uint32_t STATUS_LED_OK;
 extern const uint32_t STATUS_LED_WARNING;
 extern const uint32_t STATUS_LED_ERROR;
 
+#ifdef USE_COMPONENT_PROFILER
+/// Time spent in the loop() and the timeout/interval callbacks of a component.
+struct ComponentRuntimeStats {
+  /// Bucket i counts the calls that took at most 2^i µs (and more than 2^(i-1) µs), the last one all longer calls.
+  static const uint8_t HISTOGRAM_BUCKETS = 20;
+
+  uint32_t call_count{0};
+  uint64_t total_time_us{0};
+  uint32_t max_time_us{0};
+  uint32_t histogram[HISTOGRAM_BUCKETS]{};
+  /// Duration of setup(), not included in the loop statistics above.
+  uint32_t setup_time_us{0};
+
+  void record(uint32_t time_us);
+  /// Clear the loop statistics, keeps setup_time_us.
+  void reset();
+};
+#endif
+
 class Component {
  public:
   /** Where the component's initialization should happen.
@@ -93,6 +114,17 @@ class Component {
    */
   virtual float get_loop_priority() const;
 
+  /** Whether the main loop may sleep for up to a second without calling loop().
+   *
+   * Return true if loop() only has work after a timeout/interval ran or a wakeup source called App.wake_loop(),
+   * or if polling at that rate is good enough. Only if all looping components return true, the main loop sleeps
+   * until the next timeout/interval or wakeup instead of running every loop_interval. Interrupts and incoming UART
+   * data don't wake the loop, components that wait for those have to keep polling.
+   *
+   * Defaults to false.
+   */
+  virtual bool can_loop_tickless() const;
+
   void call();
 
   virtual void on_shutdown() {}
@@ -130,6 +162,15 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /// Set the source of this component for diagnostics, such as "dht.sensor". Generated when the profiler is enabled.
+  void set_component_source(const char *source) { this->component_source_ = source; }
+  /// Get the source of this component for diagnostics, "<unknown>" if it wasn't set.
+  const char *get_component_source() const;
+
+#ifdef USE_COMPONENT_PROFILER
+  ComponentRuntimeStats &get_runtime_stats() { return this->runtime_stats_; }
+#endif
+
  protected:
   virtual void call_loop();
   virtual void call_setup();
@@ -152,6 +193,13 @@ class Component {
 
   void set_interval(uint32_t interval, std::function<void()> &&f);  // NOLINT
 
+  /** Set an interval function with a numeric id, for example `const_fnv1_hash("update")`.
+   *
+   * Same as set_interval() with a name, but the id is not hashed at runtime and small lambdas
+   * are stored without any heap allocation. A name and its const_fnv1_hash() refer to the same interval.
+   */
+  void set_interval(uint32_t id, uint32_t interval, InlineFunction<void()> &&f);  // NOLINT
+
   /** Cancel an interval function.
    *
    * @param name The identifier for this interval function.
@@ -159,6 +207,8 @@ class Component {
    */
   bool cancel_interval(const std::string &name);  // NOLINT
 
+  bool cancel_interval(uint32_t id);  // NOLINT
+
   void set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
   /** Set a timeout function with a unique name.
@@ -177,6 +227,9 @@ class Component {
    */
   void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
+  /// Set a timeout function with a numeric id, see set_interval(uint32_t, uint32_t, InlineFunction<void()> &&).
+  void set_timeout(uint32_t id, uint32_t timeout, InlineFunction<void()> &&f);  // NOLINT
+
   /** Cancel a timeout function.
    *
    * @param name The identifier for this timeout function.
@@ -184,6 +237,8 @@ class Component {
    */
   bool cancel_timeout(const std::string &name);  // NOLINT
 
+  bool cancel_timeout(uint32_t id);  // NOLINT
+
   /** Defer a callback to the next loop() call.
    *
    * If name is specified and a defer() object with the same name exists, the old one is first removed.
@@ -201,6 +256,10 @@ class Component {
 
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
+  const char *component_source_{nullptr};
+#ifdef USE_COMPONENT_PROFILER
+  ComponentRuntimeStats runtime_stats_;
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -48,6 +48,8 @@ LoopTrigger = cg.esphome_ns.class_(
 VERSION_REGEX = re.compile(r"^[0-9]+\.[0-9]+\.[0-9]+(?:[ab]\d+)?$")
 
 CONF_NAME_ADD_MAC_SUFFIX = "name_add_mac_suffix"
+CONF_SCHEDULER = "scheduler"
+CONF_FLASH_WRITE_INTERVAL = "flash_write_interval"
 
 
 def validate_board(value):
@@ -195,6 +197,12 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Optional(CONF_INCLUDES, default=[]): cv.ensure_list(valid_include),
         cv.Optional(CONF_LIBRARIES, default=[]): cv.ensure_list(cv.string_strict),
         cv.Optional(CONF_NAME_ADD_MAC_SUFFIX, default=False): cv.boolean,
+        cv.Optional(CONF_SCHEDULER, default="heap"): cv.one_of(
+            "heap", "timer_wheel", lower=True
+        ),
+        cv.Optional(
+            CONF_FLASH_WRITE_INTERVAL, default="1min"
+        ): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_PROJECT): cv.Schema(
             {
                 cv.Required(CONF_NAME): cv.All(cv.string_strict, valid_project_name),
@@ -323,6 +331,11 @@ async def to_code(config):
             config[CONF_NAME_ADD_MAC_SUFFIX],
         )
     )
+    cg.add(
+        cg.RawExpression(
+            f"global_preferences.set_flash_write_interval({config[CONF_FLASH_WRITE_INTERVAL].total_milliseconds})"
+        )
+    )
 
     CORE.add_job(_add_automations, config)
 
@@ -345,6 +358,8 @@ async def to_code(config):
     cg.add_build_flag("-Wno-sign-compare")
     if config.get(CONF_ESP8266_RESTORE_FROM_FLASH, False):
         cg.add_define("USE_ESP8266_PREFERENCES_FLASH")
+    if config[CONF_SCHEDULER] == "timer_wheel":
+        cg.add_define("USE_SCHEDULER_TIMER_WHEEL")
 
     if config[CONF_INCLUDES]:
         CORE.add_job(add_includes, config[CONF_INCLUDES])
@@ -199,27 +199,6 @@ template<bool B, class T = void> using enable_if_t = typename std::enable_if<B,
 template<typename T, enable_if_t<!std::is_pointer<T>::value, int> = 0> T id(T value) { return value; }
 template<typename T, enable_if_t<std::is_pointer<T *>::value, int> = 0> T &id(T *value) { return *value; }
 
-template<typename... X> class CallbackManager;
-
-/** Simple helper class to allow having multiple subscribers to a signal.
- *
- * @tparam Ts The arguments for the callback, wrapped in void().
- */
-template<typename... Ts> class CallbackManager<void(Ts...)> {
- public:
-  /// Add a callback to the internal callback list.
-  void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
-
-  /// Call all callbacks in this manager.
-  void call(Ts... args) {
-    for (auto &cb : this->callbacks_)
-      cb(args...);
-  }
-
- protected:
-  std::vector<std::function<void(Ts...)>> callbacks_;
-};
-
 // https://stackoverflow.com/a/37161919/8924614
 template<class T, class... Args>
 struct is_callable  // NOLINT
@@ -322,6 +301,161 @@ template<typename T> class Parented {
 
 uint32_t fnv1_hash(const std::string &str);
 
+/// FNV-1 hash of a C string that can be evaluated at compile time. Yields the same value as fnv1_hash().
+constexpr uint32_t const_fnv1_hash(const char *str, uint32_t hash = 2166136261UL) {
+  return *str == 0 ? hash : const_fnv1_hash(str + 1, (hash * 16777619UL) ^ static_cast<uint32_t>(*str));
+}
+
+template<typename T, size_t N = 4 * sizeof(void *)> class InlineFunction;
+
+/** A move-only std::function replacement that stores small callables inline.
+ *
+ * Callables of at most N bytes (for example lambdas capturing a few pointers, or a std::function itself)
+ * are stored inside the object, so creating, moving and destroying an InlineFunction doesn't touch the heap.
+ * Larger callables fall back to a heap allocation.
+ *
+ * @tparam R The return type, wrapped in R(Args...).
+ * @tparam N The size of the inline storage in bytes.
+ */
+template<typename R, typename... Args, size_t N> class InlineFunction<R(Args...), N> {
+ public:
+  InlineFunction() = default;
+  InlineFunction(std::nullptr_t) {}  // NOLINT
+  template<typename F, enable_if_t<!std::is_same<typename std::decay<F>::type, InlineFunction>::value &&
+                                       is_callable<typename std::decay<F>::type, Args...>::value,
+                                   int> = 0>
+  InlineFunction(F &&f) {  // NOLINT
+    this->assign_(std::forward<F>(f));
+  }
+  InlineFunction(InlineFunction &&other) noexcept { this->move_from_(other); }
+  InlineFunction(const InlineFunction &) = delete;
+  ~InlineFunction() { this->reset(); }
+
+  InlineFunction &operator=(InlineFunction &&other) noexcept {
+    if (this != &other) {
+      this->reset();
+      this->move_from_(other);
+    }
+    return *this;
+  }
+  InlineFunction &operator=(const InlineFunction &) = delete;
+  InlineFunction &operator=(std::nullptr_t) {
+    this->reset();
+    return *this;
+  }
+
+  explicit operator bool() const { return this->ops_ != nullptr; }
+
+  R operator()(Args... args) const { return this->ops_->invoke(&this->storage_, args...); }
+
+  void reset() {
+    if (this->ops_ != nullptr) {
+      this->ops_->destroy(&this->storage_);
+      this->ops_ = nullptr;
+    }
+  }
+
+ protected:
+  using Storage = typename std::aligned_storage<N, alignof(void *)>::type;
+
+  struct Ops {
+    R (*invoke)(void *storage, Args... args);
+    /// Move-construct the callable in dst from src and destroy src.
+    void (*move)(void *dst, void *src);
+    void (*destroy)(void *storage);
+  };
+
+  template<typename F> struct InlineOps {
+    static R invoke(void *storage, Args... args) { return (*static_cast<F *>(storage))(args...); }
+    static void move(void *dst, void *src) {
+      new (dst) F(std::move(*static_cast<F *>(src)));
+      static_cast<F *>(src)->~F();
+    }
+    static void destroy(void *storage) { static_cast<F *>(storage)->~F(); }
+    static const Ops *get() {
+      static const Ops OPS = {&invoke, &move, &destroy};
+      return &OPS;
+    }
+  };
+
+  template<typename F> struct HeapOps {
+    static R invoke(void *storage, Args... args) { return (**static_cast<F **>(storage))(args...); }
+    static void move(void *dst, void *src) { *static_cast<F **>(dst) = *static_cast<F **>(src); }
+    static void destroy(void *storage) { delete *static_cast<F **>(storage); }
+    static const Ops *get() {
+      static const Ops OPS = {&invoke, &move, &destroy};
+      return &OPS;
+    }
+  };
+
+  template<typename F> void assign_(F &&f) {
+    using Fn = typename std::decay<F>::type;
+    this->emplace_<Fn>(std::forward<F>(f),
+                       std::integral_constant<bool, sizeof(Fn) <= sizeof(Storage) && alignof(Fn) <= alignof(Storage) &&
+                                                        std::is_nothrow_move_constructible<Fn>::value>());
+  }
+  template<typename Fn, typename F> void emplace_(F &&f, std::true_type is_inline) {
+    new (&this->storage_) Fn(std::forward<F>(f));
+    this->ops_ = InlineOps<Fn>::get();
+  }
+  template<typename Fn, typename F> void emplace_(F &&f, std::false_type is_inline) {
+    *reinterpret_cast<Fn **>(&this->storage_) = new Fn(std::forward<F>(f));
+    this->ops_ = HeapOps<Fn>::get();
+  }
+  void move_from_(InlineFunction &other) {
+    if (other.ops_ == nullptr)
+      return;
+    other.ops_->move(&this->storage_, &other.storage_);
+    this->ops_ = other.ops_;
+    other.ops_ = nullptr;
+  }
+
+  mutable Storage storage_;
+  const Ops *ops_{nullptr};
+};
+
+template<typename... X> class CallbackManager;
+
+/** Simple helper class to allow having multiple subscribers to a signal.
+ *
+ * Callbacks are stored as InlineFunction, so small lambdas don't need a heap allocation. The first callback is kept
+ * in the manager itself, the common case of a single subscriber doesn't allocate at all. Any further callbacks are
+ * stored contiguously and called in the order they were added.
+ *
+ * @tparam Ts The arguments for the callback, wrapped in void().
+ */
+template<typename... Ts> class CallbackManager<void(Ts...)> {
+ public:
+  using Callback = InlineFunction<void(Ts...)>;
+
+  /// Add a callback to the internal callback list.
+  void add(Callback &&callback) {
+    if (!callback)
+      return;
+    if (!this->first_) {
+      this->first_ = std::move(callback);
+    } else {
+      this->callbacks_.push_back(std::move(callback));
+    }
+  }
+
+  /// Call all callbacks in this manager.
+  void call(Ts... args) {
+    if (!this->first_)
+      return;
+    this->first_(args...);
+    for (auto &cb : this->callbacks_)
+      cb(args...);
+  }
+
+  /// The number of callbacks in this manager.
+  size_t size() const { return this->first_ ? this->callbacks_.size() + 1 : 0; }
+
+ protected:
+  Callback first_;
+  std::vector<Callback> callbacks_;
+};
+
 template<typename T> T *new_buffer(size_t length) {
   T *buffer;
 #ifdef ARDUINO_ARCH_ESP32
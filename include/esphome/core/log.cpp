@@ -46,6 +46,17 @@ void HOT esp_log_vprintf_(int level, const char *tag, int line, const __FlashStr
 }
 #endif
 
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+bool HOT esp_log_deferred_enabled_(int level, const char *tag) {
+  auto *log = logger::global_logger;
+  return log != nullptr && log->deferred_enabled_(level, tag);
+}
+uint8_t *HOT esp_log_deferred_begin_(int level, const char *tag, int line, const char *format, size_t len) {
+  return logger::global_logger->deferred_begin_(level, tag, line, format, len);
+}
+void HOT esp_log_deferred_end_(uint8_t *args, size_t len) { logger::global_logger->deferred_end_(args, len); }
+#endif
+
 #ifdef ARDUINO_ARCH_ESP32
 int HOT esp_idf_log_vprintf_(const char *format, va_list args) {  // NOLINT
 #ifdef USE_LOGGER
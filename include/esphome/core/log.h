@@ -2,13 +2,17 @@
 
 #include <cassert>
 #include <cstdarg>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <type_traits>
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 #include "WString.h"
 #endif
 
 // avoid esp-idf redefining our macros
 #include "esphome/core/esphal.h"
+#include "esphome/core/defines.h"
 
 #ifdef ARDUINO_ARCH_ESP32
 #include "esp_err.h"
@@ -65,9 +69,116 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #define ESPHOME_LOG_FORMAT(format) format
 #endif
 
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+/** Deferred formatting of verbose log messages.
+ *
+ * Instead of running vsnprintf() at the call site, ESP_LOGV and ESP_LOGVV only store the format string pointer
+ * and the raw arguments in the logger's ring buffer. The message is formatted when the logger writes it out in
+ * its loop(). Strings are copied (up to 255 characters), all other arguments are stored by value.
+ */
+/// Type tag in front of each encoded argument, 0 is left out so that the zeroed record padding ends the arguments.
+enum class DeferredLogArg : uint8_t { INT32 = 1, INT64, DOUBLE, STRING, POINTER };
+
+class DeferredLogEncoder {
+ public:
+  static size_t size() { return 0; }
+  template<typename T, typename... Ts> static size_t size(T arg, Ts... args) {
+    return 1 + arg_size(arg) + size(args...);
+  }
+
+  static uint8_t *write(uint8_t *out) { return out; }
+  template<typename T, typename... Ts> static uint8_t *write(uint8_t *out, T arg, Ts... args) {
+    return write(write_arg(out, arg), args...);
+  }
+
+ protected:
+  static size_t string_length(const char *value) {
+    size_t len = value == nullptr ? 6 : strlen(value);
+    return len > 255 ? 255 : len;
+  }
+
+  template<typename T> static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, size_t>::type
+  arg_size(T value) {
+    return sizeof(T) > 4 ? 8 : 4;
+  }
+  static size_t arg_size(double value) { return 8; }
+  static size_t arg_size(const char *value) { return 1 + string_length(value) + 1; }
+  static size_t arg_size(char *value) { return arg_size(static_cast<const char *>(value)); }
+  static size_t arg_size(const void *value) { return sizeof(uintptr_t); }
+
+  template<typename T>
+  static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, uint8_t *>::type write_arg(
+      uint8_t *out, T value) {
+    if (sizeof(T) > 4) {
+      *out++ = static_cast<uint8_t>(DeferredLogArg::INT64);
+      int64_t raw = static_cast<int64_t>(value);
+      memcpy(out, &raw, 8);
+      return out + 8;
+    }
+    *out++ = static_cast<uint8_t>(DeferredLogArg::INT32);
+    int32_t raw = static_cast<int32_t>(value);
+    memcpy(out, &raw, 4);
+    return out + 4;
+  }
+  static uint8_t *write_arg(uint8_t *out, double value) {
+    *out++ = static_cast<uint8_t>(DeferredLogArg::DOUBLE);
+    memcpy(out, &value, 8);
+    return out + 8;
+  }
+  static uint8_t *write_arg(uint8_t *out, const char *value) {
+    *out++ = static_cast<uint8_t>(DeferredLogArg::STRING);
+    const size_t len = string_length(value);
+    *out++ = len;
+    memcpy(out, value == nullptr ? "(null)" : value, len);
+    out[len] = '\0';
+    return out + len + 1;
+  }
+  static uint8_t *write_arg(uint8_t *out, char *value) { return write_arg(out, static_cast<const char *>(value)); }
+  static uint8_t *write_arg(uint8_t *out, const void *value) {
+    *out++ = static_cast<uint8_t>(DeferredLogArg::POINTER);
+    uintptr_t raw = reinterpret_cast<uintptr_t>(value);
+    memcpy(out, &raw, sizeof(uintptr_t));
+    return out + sizeof(uintptr_t);
+  }
+};
+
+/// Whether a deferred message with this level and tag is written at all.
+bool esp_log_deferred_enabled_(int level, const char *tag);
+/// Reserve a deferred record for `len` bytes of arguments, returns nullptr if the message is dropped.
+uint8_t *esp_log_deferred_begin_(int level, const char *tag, int line, const char *format, size_t len);
+void esp_log_deferred_end_(uint8_t *args, size_t len);
+
+template<typename... Ts> void esp_log_deferred_(int level, const char *tag, int line, const char *format, Ts... args) {
+  // filter first, sizing the arguments runs strlen() on every string
+  if (!esp_log_deferred_enabled_(level, tag))
+    return;
+  const size_t len = DeferredLogEncoder::size(args...);
+  uint8_t *out = esp_log_deferred_begin_(level, tag, line, format, len);
+  if (out == nullptr)
+    return;
+  DeferredLogEncoder::write(out, args...);
+  esp_log_deferred_end_(out, len);
+}
+
+/// Never called, only lets the compiler check the arguments of deferred log calls against the format.
+inline void esp_log_check_format_(const char *format, ...) __attribute__((format(printf, 1, 2)));
+inline void esp_log_check_format_(const char *format, ...) {}
+
+#define esph_log_deferred_(level, tag, format, ...) \
+  do { \
+    if (false) \
+      esp_log_check_format_(format, ##__VA_ARGS__); \
+    esp_log_deferred_(level, tag, __LINE__, format, ##__VA_ARGS__); \
+  } while (false)
+#endif
+
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERY_VERBOSE
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+#define esph_log_vv(tag, format, ...) esph_log_deferred_(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag, format, ##__VA_ARGS__)
+#else
 #define esph_log_vv(tag, format, ...) \
   esp_log_printf_(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#endif
 
 #define ESPHOME_LOG_HAS_VERY_VERBOSE
 #else
@@ -75,8 +186,12 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+#define esph_log_v(tag, format, ...) esph_log_deferred_(ESPHOME_LOG_LEVEL_VERBOSE, tag, format, ##__VA_ARGS__)
+#else
 #define esph_log_v(tag, format, ...) \
   esp_log_printf_(ESPHOME_LOG_LEVEL_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#endif
 
 #define ESPHOME_LOG_HAS_VERBOSE
 #else
@@ -100,30 +100,83 @@ static const uint32_t get_esp8266_flash_sector() {
 }
 static const uint32_t get_esp8266_flash_address() { return get_esp8266_flash_sector() * SPI_FLASH_SEC_SIZE; }
 
-void ESPPreferences::save_esp8266_flash_() {
+/** The flash sector is used as a log of images of the flash preferences, each slot holds one image followed by its
+ * sequence number and checksum. New images are appended to the next free slot, the sector is only erased once all
+ * slots are used. The trailer is written after the image, so an interrupted write leaves the previous image valid.
+ */
+static const uint32_t ESP8266_FLASH_SLOT_WORDS = ESP8266_FLASH_STORAGE_SIZE + 2;
+static const uint32_t ESP8266_FLASH_SLOTS = (SPI_FLASH_SEC_SIZE / 4) / ESP8266_FLASH_SLOT_WORDS;
+static const uint32_t ESP8266_FLASH_ERASED = 0xFFFFFFFF;
+
+static uint32_t get_esp8266_flash_slot_address(uint32_t slot) {
+  return get_esp8266_flash_address() + slot * ESP8266_FLASH_SLOT_WORDS * 4;
+}
+static uint32_t esp8266_flash_checksum(const uint32_t *image, uint32_t sequence) {
+  // FNV-1a over the words of the image
+  uint32_t checksum = 2166136261UL ^ sequence;
+  for (uint32_t i = 0; i < ESP8266_FLASH_STORAGE_SIZE; i++)
+    checksum = (checksum ^ image[i]) * 16777619UL;
+  return checksum;
+}
+static bool esp8266_flash_slot_is_erased(uint32_t slot) {
+  uint32_t buffer[16];
+  for (uint32_t i = 0; i < ESP8266_FLASH_SLOT_WORDS; i += 16) {
+    const uint32_t words = std::min<uint32_t>(16, ESP8266_FLASH_SLOT_WORDS - i);
+    {
+      InterruptLock lock;
+      spi_flash_read(get_esp8266_flash_slot_address(slot) + i * 4, buffer, words * 4);
+    }
+    for (uint32_t j = 0; j < words; j++) {
+      if (buffer[j] != ESP8266_FLASH_ERASED)
+        return false;
+    }
+  }
+  return true;
+}
+
+bool ESPPreferences::save_esp8266_flash_() {
   if (!esp8266_flash_dirty)
-    return;
+    return true;
+
+  const bool erase = this->next_flash_slot_ >= ESP8266_FLASH_SLOTS;
+  const uint32_t slot = erase ? 0 : this->next_flash_slot_;
+  const uint32_t address = get_esp8266_flash_slot_address(slot);
+  uint32_t trailer[2];
+  trailer[0] = this->flash_sequence_ + 1;
+  trailer[1] = esp8266_flash_checksum(this->flash_storage_, trailer[0]);
 
-  ESP_LOGVV(TAG, "Saving preferences to flash...");
-  SpiFlashOpResult erase_res, write_res = SPI_FLASH_RESULT_OK;
+  ESP_LOGVV(TAG, "Saving preferences to flash slot %u...", slot);
+  SpiFlashOpResult erase_res = SPI_FLASH_RESULT_OK, write_res = SPI_FLASH_RESULT_OK;
   {
     InterruptLock lock;
-    erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
+    if (erase)
+      erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
     if (erase_res == SPI_FLASH_RESULT_OK) {
-      write_res = spi_flash_write(get_esp8266_flash_address(), this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE * 4);
+      write_res = spi_flash_write(address, this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE * 4);
+      if (write_res == SPI_FLASH_RESULT_OK)
+        write_res = spi_flash_write(address + ESP8266_FLASH_STORAGE_SIZE * 4, trailer, sizeof(trailer));
     }
   }
   if (erase_res != SPI_FLASH_RESULT_OK) {
     ESP_LOGV(TAG, "Erase ESP8266 flash failed!");
-    return;
+    return false;
   }
+  if (erase)
+    this->erase_count_++;
   if (write_res != SPI_FLASH_RESULT_OK) {
     ESP_LOGV(TAG, "Write ESP8266 flash failed!");
-    return;
+    // The slot might be partially written, start over in a freshly erased sector
+    this->next_flash_slot_ = ESP8266_FLASH_SLOTS;
+    return false;
   }
 
+  this->write_count_++;
+  this->flash_sequence_ = trailer[0];
+  this->next_flash_slot_ = slot + 1;
   esp8266_flash_dirty = false;
+  return true;
 }
+bool ESPPreferences::sync_internal_() { return this->save_esp8266_flash_(); }
 
 bool ESPPreferenceObject::save_internal_() {
   if (this->in_flash_) {
@@ -137,7 +190,13 @@ bool ESPPreferenceObject::save_internal_() {
         esp8266_flash_dirty = true;
       *ptr = v;
     }
-    global_preferences.save_esp8266_flash_();
+    if (!esp8266_flash_dirty) {
+      global_preferences.skipped_count_++;
+      return true;
+    }
+    global_preferences.mark_pending_();
+    if (global_preferences.flash_write_interval_ == 0)
+      return global_preferences.sync();
     return true;
   }
 
@@ -174,9 +233,38 @@ ESPPreferences::ESPPreferences()
 
 void ESPPreferences::begin() {
   this->flash_storage_ = new uint32_t[ESP8266_FLASH_STORAGE_SIZE];
+  this->next_flash_slot_ = ESP8266_FLASH_SLOTS;
   ESP_LOGVV(TAG, "Loading preferences from flash...");
 
-  {
+  // The slots are filled in order, so the newest valid image is the last one
+  bool found = false;
+  bool torn = false;
+  for (uint32_t slot = ESP8266_FLASH_SLOTS; slot-- > 0;) {
+    uint32_t trailer[2];
+    {
+      InterruptLock lock;
+      spi_flash_read(get_esp8266_flash_slot_address(slot) + ESP8266_FLASH_STORAGE_SIZE * 4, trailer, sizeof(trailer));
+    }
+    if (trailer[0] == ESP8266_FLASH_ERASED && trailer[1] == ESP8266_FLASH_ERASED)
+      continue;
+    {
+      InterruptLock lock;
+      spi_flash_read(get_esp8266_flash_slot_address(slot), this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE * 4);
+    }
+    if (trailer[1] != esp8266_flash_checksum(this->flash_storage_, trailer[0])) {
+      torn = true;
+      continue;
+    }
+    found = true;
+    this->flash_sequence_ = trailer[0];
+    // Only append if the following slot wasn't touched by an interrupted write
+    if (!torn && slot + 1 < ESP8266_FLASH_SLOTS && esp8266_flash_slot_is_erased(slot + 1))
+      this->next_flash_slot_ = slot + 1;
+    break;
+  }
+
+  if (!found) {
+    // Sector written by an older version as one plain image, the first save erases it
     InterruptLock lock;
     spi_flash_read(get_esp8266_flash_address(), this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE * 4);
   }
@@ -231,25 +319,31 @@ bool ESPPreferenceObject::save_internal_() {
   if (global_preferences.nvs_handle_ == 0)
     return false;
 
-  char key[32];
-  sprintf(key, "%u", this->offset_);
-  uint32_t len = (this->length_words_ + 1) * 4;
-  esp_err_t err = nvs_set_blob(global_preferences.nvs_handle_, key, this->data_, len);
-  if (err) {
-    ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", key, len, esp_err_to_name(err));
-    return false;
-  }
-  err = nvs_commit(global_preferences.nvs_handle_);
-  if (err) {
-    ESP_LOGV(TAG, "nvs_commit('%s', len=%u) failed: %s", key, len, esp_err_to_name(err));
-    return false;
+  bool pending = false;
+  for (auto &pref : global_preferences.pending_) {
+    // copies of the object share the data buffer
+    if (pref.offset_ == this->offset_) {
+      pending = true;
+      break;
+    }
   }
+  if (!pending)
+    global_preferences.pending_.push_back(*this);
+  global_preferences.mark_pending_();
+  if (global_preferences.flash_write_interval_ == 0)
+    return global_preferences.sync();
   return true;
 }
 bool ESPPreferenceObject::load_internal_() {
   if (global_preferences.nvs_handle_ == 0)
     return false;
 
+  for (auto &pref : global_preferences.pending_) {
+    // not written yet, the data buffer holds the latest saved value
+    if (pref.offset_ == this->offset_)
+      return true;
+  }
+
   char key[32];
   sprintf(key, "%u", this->offset_);
   size_t len = (this->length_words_ + 1) * 4;
@@ -288,12 +382,77 @@ void ESPPreferences::begin() {
   }
 }
 
+bool ESPPreferences::sync_internal_() {
+  if (this->nvs_handle_ == 0)
+    return false;
+
+  std::vector<ESPPreferenceObject> failed;
+  bool written = false;
+  for (auto &pref : this->pending_) {
+    char key[32];
+    sprintf(key, "%u", pref.offset_);
+    size_t len = (pref.length_words_ + 1) * 4;
+
+    // Every NVS write uses new entries in flash, even if the value didn't change
+    std::vector<uint32_t> stored(pref.length_words_ + 1);
+    size_t stored_len = len;
+    if (nvs_get_blob(this->nvs_handle_, key, stored.data(), &stored_len) == ESP_OK && stored_len == len &&
+        memcmp(stored.data(), pref.data_, len) == 0) {
+      this->skipped_count_++;
+      continue;
+    }
+
+    esp_err_t err = nvs_set_blob(this->nvs_handle_, key, pref.data_, len);
+    if (err) {
+      ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", key, len, esp_err_to_name(err));
+      failed.push_back(pref);
+      continue;
+    }
+    this->write_count_++;
+    written = true;
+  }
+  this->pending_.swap(failed);
+
+  if (written) {
+    esp_err_t err = nvs_commit(this->nvs_handle_);
+    if (err) {
+      ESP_LOGV(TAG, "nvs_commit() failed: %s", esp_err_to_name(err));
+      return false;
+    }
+  }
+  return this->pending_.empty();
+}
+
 ESPPreferenceObject ESPPreferences::make_preference(size_t length, uint32_t type, bool in_flash) {
   auto pref = ESPPreferenceObject(this->current_offset_, length, type);
   this->current_offset_++;
   return pref;
 }
 #endif
+void ESPPreferences::mark_pending_() {
+  if (this->sync_pending_)
+    return;
+  this->sync_pending_ = true;
+  this->pending_since_ = millis();
+}
+bool ESPPreferences::sync() {
+  if (!this->sync_pending_)
+    return true;
+
+  if (!this->sync_internal_()) {
+    // retry after another interval
+    this->pending_since_ = millis();
+    return false;
+  }
+  this->sync_pending_ = false;
+  ESP_LOGV(TAG, "Wrote preferences to flash (%u writes, %u skipped so far)", this->write_count_,
+           this->skipped_count_);
+  return true;
+}
+void ESPPreferences::loop() {
+  if (this->sync_pending_ && millis() - this->pending_since_ >= this->flash_write_interval_)
+    this->sync();
+}
 uint32_t ESPPreferenceObject::calculate_crc_() const {
   uint32_t crc = this->type_;
   for (size_t i = 0; i < this->length_words_; i++) {
@@ -301,6 +460,18 @@ uint32_t ESPPreferenceObject::calculate_crc_() const {
   }
   return crc;
 }
+bool ESPPreferenceObject::save(const uint32_t *src, size_t length_words) {
+  if (!this->is_initialized() || length_words != this->length_words_)
+    return false;
+  memcpy(this->data_, src, length_words * 4);
+  return this->save_();
+}
+bool ESPPreferenceObject::load(uint32_t *dest, size_t length_words) {
+  if (length_words != this->length_words_ || !this->load_())
+    return false;
+  memcpy(dest, this->data_, length_words * 4);
+  return true;
+}
 bool ESPPreferenceObject::is_initialized() const { return this->data_ != nullptr; }
 
 ESPPreferences global_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
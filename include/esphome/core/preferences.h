@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "esphome/core/esphal.h"
 #include "esphome/core/defines.h"
@@ -16,6 +17,11 @@ class ESPPreferenceObject {
 
   template<typename T> bool load(T *dest);
 
+  /// Save a preference whose length is only known at runtime, src holds length_words words.
+  bool save(const uint32_t *src, size_t length_words);
+  /// Load a preference whose length is only known at runtime, dest receives length_words words.
+  bool load(uint32_t *dest, size_t length_words);
+
   bool is_initialized() const;
 
  protected:
@@ -56,6 +62,22 @@ class ESPPreferences {
   ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash = DEFAULT_IN_FLASH);
   template<typename T> ESPPreferenceObject make_preference(uint32_t type, bool in_flash = DEFAULT_IN_FLASH);
 
+  /** Set how long saved preferences are kept in RAM before they're written to flash, 0 writes them immediately.
+   *
+   * All preferences saved within the interval are written together, a preference that's saved repeatedly is only
+   * written once with its latest value. Pending writes are flushed by sync() before the node reboots.
+   */
+  void set_flash_write_interval(uint32_t flash_write_interval) { this->flash_write_interval_ = flash_write_interval; }
+  /// Write all pending preferences to flash now, returns false if a write failed.
+  bool sync();
+  /// Write the pending preferences once the flash write interval elapsed, called by the application loop.
+  void loop();
+
+  /// Number of flash writes so far (NVS entries on the ESP32, slots of the flash sector on the ESP8266).
+  uint32_t get_write_count() const { return this->write_count_; }
+  /// Number of writes that were skipped because the data in flash was the same already.
+  uint32_t get_skipped_count() const { return this->skipped_count_; }
+
 #ifdef ARDUINO_ARCH_ESP8266
   /** On the ESP8266, we can't override the first 128 bytes during OTA uploads
    * as the eboot parameters are stored there. Writing there during an OTA upload
@@ -66,20 +88,40 @@ class ESPPreferences {
    */
   void prevent_write(bool prevent);
   bool is_prevent_write();
+
+  /// Number of flash sector erases so far.
+  uint32_t get_erase_count() const { return this->erase_count_; }
 #endif
 
  protected:
   friend ESPPreferenceObject;
 
+  /// Remember that there are pending writes, the interval starts with the first one.
+  void mark_pending_();
+  /// Write the pending preferences of the platform.
+  bool sync_internal_();
+
   uint32_t current_offset_;
+  uint32_t flash_write_interval_{60000};
+  uint32_t pending_since_{0};
+  bool sync_pending_{false};
+  uint32_t write_count_{0};
+  uint32_t skipped_count_{0};
 #ifdef ARDUINO_ARCH_ESP32
   uint32_t nvs_handle_;
+  /// The preferences that were saved since the last sync, at most one object per key.
+  std::vector<ESPPreferenceObject> pending_;
 #endif
 #ifdef ARDUINO_ARCH_ESP8266
-  void save_esp8266_flash_();
+  bool save_esp8266_flash_();
   bool prevent_write_{false};
   uint32_t *flash_storage_;
   uint32_t current_flash_offset_;
+  /// The slot of the flash sector the next image is written to, a value past the last slot erases the sector first.
+  uint32_t next_flash_slot_;
+  /// Sequence number of the image that was written last.
+  uint32_t flash_sequence_{0};
+  uint32_t erase_count_{0};
 #endif
 };
 
@@ -98,7 +140,6 @@ template<typename T> bool ESPPreferenceObject::save(T *src) {
 }
 
 template<typename T> bool ESPPreferenceObject::load(T *dest) {
-  memset(this->data_, 0, this->length_words_ * 4);
   if (!this->load_())
     return false;
 
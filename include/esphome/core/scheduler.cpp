@@ -9,42 +9,74 @@ static const char *const TAG = "scheduler";
 
 static const uint32_t SCHEDULER_DONT_RUN = 4294967295UL;
 static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+static const uint32_t SCHEDULER_POOL_BLOCK_SIZE = 16;
 
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
 
 void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
                                 std::function<void()> &&func) {
+  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%u)", name.c_str(), timeout);
+  this->set_timeout_(component, !name.empty(), fnv1_hash(name), &name, timeout, std::move(func));
+}
+void HOT Scheduler::set_timeout(Component *component, uint32_t id, uint32_t timeout, SchedulerCallback &&func) {
+  this->set_timeout_(component, true, id, nullptr, timeout, std::move(func));
+}
+void HOT Scheduler::set_timeout(Component *component, uint32_t timeout, SchedulerCallback &&func) {
+  this->set_timeout_(component, false, 0, nullptr, timeout, std::move(func));
+}
+void HOT Scheduler::set_timeout_(Component *component, bool has_id, uint32_t id, const std::string *name,
+                                 uint32_t timeout, SchedulerCallback &&func) {
   const uint32_t now = this->millis_();
 
-  if (!name.empty())
-    this->cancel_timeout(component, name);
+  if (has_id)
+    this->cancel_item_(component, true, id, name, SchedulerItem::TIMEOUT);
 
   if (timeout == SCHEDULER_DONT_RUN)
     return;
 
-  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%u)", name.c_str(), timeout);
+  ESP_LOGVV(TAG, "set_timeout(id=0x%08X, timeout=%u)", id, timeout);
 
-  auto item = make_unique<SchedulerItem>();
+  auto *item = this->alloc_item_();
   item->component = component;
-  item->name = name;
+  item->id = id;
+  item->has_id = has_id;
+  if (has_id && name != nullptr) {
+    item->name = *name;
+  } else {
+    item->name.clear();
+  }
   item->type = SchedulerItem::TIMEOUT;
   item->timeout = timeout;
   item->last_execution = now;
   item->last_execution_major = this->millis_major_;
   item->f = std::move(func);
   item->remove = false;
-  this->push_(std::move(item));
+  this->push_(item);
 }
 bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
+  return this->cancel_item_(component, !name.empty(), fnv1_hash(name), &name, SchedulerItem::TIMEOUT);
+}
+bool HOT Scheduler::cancel_timeout(Component *component, uint32_t id) {
+  return this->cancel_item_(component, true, id, nullptr, SchedulerItem::TIMEOUT);
 }
 void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
                                  std::function<void()> &&func) {
+  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u)", name.c_str(), interval);
+  this->set_interval_(component, !name.empty(), fnv1_hash(name), &name, interval, std::move(func));
+}
+void HOT Scheduler::set_interval(Component *component, uint32_t id, uint32_t interval, SchedulerCallback &&func) {
+  this->set_interval_(component, true, id, nullptr, interval, std::move(func));
+}
+void HOT Scheduler::set_interval(Component *component, uint32_t interval, SchedulerCallback &&func) {
+  this->set_interval_(component, false, 0, nullptr, interval, std::move(func));
+}
+void HOT Scheduler::set_interval_(Component *component, bool has_id, uint32_t id, const std::string *name,
+                                  uint32_t interval, SchedulerCallback &&func) {
   const uint32_t now = this->millis_();
 
-  if (!name.empty())
-    this->cancel_interval(component, name);
+  if (has_id)
+    this->cancel_item_(component, true, id, name, SchedulerItem::INTERVAL);
 
   if (interval == SCHEDULER_DONT_RUN)
     return;
@@ -54,11 +86,17 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
   if (interval != 0)
     offset = (random_uint32() % interval) / 2;
 
-  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u, offset=%u)", name.c_str(), interval, offset);
+  ESP_LOGVV(TAG, "set_interval(id=0x%08X, interval=%u, offset=%u)", id, interval, offset);
 
-  auto item = make_unique<SchedulerItem>();
+  auto *item = this->alloc_item_();
   item->component = component;
-  item->name = name;
+  item->id = id;
+  item->has_id = has_id;
+  if (has_id && name != nullptr) {
+    item->name = *name;
+  } else {
+    item->name.clear();
+  }
   item->type = SchedulerItem::INTERVAL;
   item->interval = interval;
   item->last_execution = now - offset - interval;
@@ -67,12 +105,282 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
     item->last_execution_major--;
   item->f = std::move(func);
   item->remove = false;
-  this->push_(std::move(item));
+  this->push_(item);
 }
 bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
+  return this->cancel_item_(component, !name.empty(), fnv1_hash(name), &name, SchedulerItem::INTERVAL);
 }
+bool HOT Scheduler::cancel_interval(Component *component, uint32_t id) {
+  return this->cancel_item_(component, true, id, nullptr, SchedulerItem::INTERVAL);
+}
+#ifdef USE_SCHEDULER_TIMER_WHEEL
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
+  // Items added since the last call() can be due right away, the loop must not sleep past them
+  if (!this->to_add_.empty())
+    return 0;
+  if (this->wheel_size_ == 0)
+    return {};
+  const uint32_t now = this->millis_();
+  // Items on level 0 are due within this revolution, anything else can't be due before the next cascade
+  const uint32_t index = this->wheel_time_ & (WHEEL_SLOTS - 1);
+  const uint64_t pending = this->occupied_[0] & (~0ULL << index);
+  uint32_t next_time = this->wheel_time_ + WHEEL_SLOTS - index;
+  if (pending != 0)
+    next_time = this->wheel_time_ + __builtin_ctzll(pending) - index;
+  if (static_cast<int32_t>(next_time - now) <= 0)
+    return 0;
+  return next_time - now;
+}
+void ICACHE_RAM_ATTR HOT Scheduler::call() {
+  const uint32_t now = this->millis_();
+  this->process_to_add();
+
+#ifdef ESPHOME_DEBUG_SCHEDULER
+  static uint32_t last_print = 0;
+
+  if (now - last_print > 2000) {
+    last_print = now;
+    ESP_LOGVV(TAG, "Items: count=%u, now=%u, wheel_time=%u", this->wheel_size_, now, this->wheel_time_);
+    for (uint16_t slot = 0; slot <= WHEEL_FAR; slot++) {
+      for (auto *item = this->slots_[slot]; item != nullptr; item = item->next) {
+        const char *type = item->type == SchedulerItem::INTERVAL ? "interval" : "timeout";
+        ESP_LOGVV(TAG, "  %s 0x%08X interval=%u slot=%u expires=%u", type, item->id, item->interval, slot,
+                  item->expires);
+      }
+    }
+    ESP_LOGVV(TAG, "\n");
+  }
+#endif  // ESPHOME_DEBUG_SCHEDULER
+
+  this->wheel_advance_(now);
+
+  while (this->expired_head_ != nullptr) {
+    auto *item = this->expired_head_;
+    this->expired_head_ = item->next;
+
+    // Cancelled by a callback that ran before this one
+    if (item->remove) {
+      this->free_item_(item);
+      continue;
+    }
+
+    // Don't run on failed components
+    if (item->component != nullptr && item->component->is_failed()) {
+      this->free_item_(item);
+      continue;
+    }
+
+#ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
+    const char *type = item->type == SchedulerItem::INTERVAL ? "interval" : "timeout";
+    ESP_LOGVV(TAG, "Running %s 0x%08X with interval=%u last_execution=%u (now=%u)", type, item->id, item->interval,
+              item->last_execution, now);
+#endif
+
+    // The item is in neither the wheel nor to_add_ while it runs, cancelling it only sets the remove flag.
+    this->run_item_(item);
+
+    if (item->remove) {
+      // We were removed/cancelled in the function call, stop
+      this->free_item_(item);
+      continue;
+    }
+
+    if (item->type == SchedulerItem::INTERVAL) {
+      if (item->interval != 0) {
+        const uint32_t amount = (now - item->last_execution) / item->interval;
+        item->last_execution += amount * item->interval;
+      }
+      this->to_add_.push_back(item);
+    } else {
+      this->free_item_(item);
+    }
+  }
+  this->expired_tail_ = nullptr;
+
+  this->process_to_add();
+}
+void HOT Scheduler::process_to_add() {
+  if (this->to_add_.empty())
+    return;
+
+  const uint32_t now = this->millis_();
+  if (this->wheel_size_ == 0)
+    // nothing to cascade, the wheel can start at any tick
+    this->wheel_time_ = now;
+
+  for (auto *it : this->to_add_) {
+    if (it->remove) {
+      this->free_item_(it);
+      continue;
+    }
+
+    // Same due check as the heap implementation, then convert to ticks relative to the wheel
+    const uint32_t elapsed = now - it->last_execution;
+    uint32_t delta = it->interval > elapsed ? it->interval - elapsed : 0;
+    const int32_t lag = static_cast<int32_t>(now - this->wheel_time_);
+    if (lag >= 0) {
+      delta = delta + lag < delta ? UINT32_MAX : delta + lag;
+    } else {
+      delta = delta > static_cast<uint32_t>(-lag) ? delta + lag : 0;
+    }
+    this->wheel_insert_(it, delta);
+  }
+  this->to_add_.clear();
+}
+bool HOT Scheduler::cancel_item_(Component *component, bool has_id, uint32_t id, const std::string *name,
+                                 Scheduler::SchedulerItem::Type type) {
+  if (!has_id)
+    return this->cancel_anonymous_(component, type);
+
+  bool ret = false;
+  SchedulerItem *it = this->id_bucket_(component, id);
+  while (it != nullptr) {
+    auto *next = it->id_next;
+    if (!it->remove && matches_(it, component, true, id, name, type)) {
+      ret = true;
+      if (it->slot != WHEEL_NONE) {
+        this->wheel_unlink_(it);
+        this->free_item_(it);
+      } else {
+        // pending in to_add_, expired or currently running; freed by call() or process_to_add()
+        it->remove = true;
+      }
+    }
+    it = next;
+  }
+
+  return ret;
+}
+bool Scheduler::cancel_anonymous_(Component *component, Scheduler::SchedulerItem::Type type) {
+  bool ret = false;
+  for (uint16_t slot = 0; slot <= WHEEL_FAR; slot++) {
+    SchedulerItem *it = this->slots_[slot];
+    while (it != nullptr) {
+      auto *next = it->next;
+      if (!it->remove && matches_(it, component, false, 0, nullptr, type)) {
+        this->wheel_unlink_(it);
+        this->free_item_(it);
+        ret = true;
+      }
+      it = next;
+    }
+  }
+  // due or pending items are freed by call() or process_to_add()
+  for (SchedulerItem *it = this->expired_head_; it != nullptr; it = it->next) {
+    if (!it->remove && matches_(it, component, false, 0, nullptr, type)) {
+      it->remove = true;
+      ret = true;
+    }
+  }
+  for (auto *it : this->to_add_) {
+    if (!it->remove && matches_(it, component, false, 0, nullptr, type)) {
+      it->remove = true;
+      ret = true;
+    }
+  }
+  return ret;
+}
+void HOT Scheduler::wheel_insert_(Scheduler::SchedulerItem *item, uint32_t delta) {
+  const uint32_t expires = this->wheel_time_ + delta;
+  uint16_t slot = WHEEL_FAR;
+  for (uint8_t level = 0; level < WHEEL_LEVELS; level++) {
+    if (delta < (1UL << (WHEEL_BITS * (level + 1)))) {
+      const uint8_t index = (expires >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1);
+      this->occupied_[level] |= 1ULL << index;
+      slot = level * WHEEL_SLOTS + index;
+      break;
+    }
+  }
+
+  item->expires = expires;
+  item->slot = slot;
+  item->prev = nullptr;
+  item->next = this->slots_[slot];
+  if (item->next != nullptr)
+    item->next->prev = item;
+  this->slots_[slot] = item;
+  this->wheel_size_++;
+}
+void HOT Scheduler::wheel_unlink_(Scheduler::SchedulerItem *item) {
+  const uint16_t slot = item->slot;
+  if (item->prev != nullptr) {
+    item->prev->next = item->next;
+  } else {
+    this->slots_[slot] = item->next;
+  }
+  if (item->next != nullptr)
+    item->next->prev = item->prev;
+  if (this->slots_[slot] == nullptr && slot != WHEEL_FAR)
+    this->occupied_[slot / WHEEL_SLOTS] &= ~(1ULL << (slot % WHEEL_SLOTS));
+  item->slot = WHEEL_NONE;
+  this->wheel_size_--;
+}
+void HOT Scheduler::wheel_cascade_(uint16_t slot) {
+  SchedulerItem *it = this->slots_[slot];
+  this->slots_[slot] = nullptr;
+  if (slot != WHEEL_FAR)
+    this->occupied_[slot / WHEEL_SLOTS] &= ~(1ULL << (slot % WHEEL_SLOTS));
+  while (it != nullptr) {
+    auto *next = it->next;
+    this->wheel_size_--;
+    this->wheel_insert_(it, it->expires - this->wheel_time_);
+    it = next;
+  }
+}
+void HOT Scheduler::wheel_advance_(uint32_t now) {
+  while (static_cast<int32_t>(now - this->wheel_time_) >= 0) {
+    if (this->wheel_size_ == 0) {
+      this->wheel_time_ = now + 1;
+      return;
+    }
+
+    const uint32_t index = this->wheel_time_ & (WHEEL_SLOTS - 1);
+    if (index == 0) {
+      // Start of a new revolution, bring the items of the next slot of the upper levels closer
+      uint8_t level = 1;
+      for (; level < WHEEL_LEVELS; level++) {
+        const uint32_t upper = (this->wheel_time_ >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1);
+        this->wheel_cascade_(level * WHEEL_SLOTS + upper);
+        if (upper != 0)
+          break;
+      }
+      if (level == WHEEL_LEVELS)
+        this->wheel_cascade_(WHEEL_FAR);
+    }
+
+    // Everything left in this slot is due now
+    SchedulerItem *it = this->slots_[index];
+    if (it != nullptr) {
+      this->slots_[index] = nullptr;
+      this->occupied_[0] &= ~(1ULL << index);
+      if (this->expired_tail_ != nullptr) {
+        this->expired_tail_->next = it;
+      } else {
+        this->expired_head_ = it;
+      }
+      for (; it != nullptr; it = it->next) {
+        it->slot = WHEEL_NONE;
+        this->wheel_size_--;
+        this->expired_tail_ = it;
+      }
+    }
+    this->wheel_time_++;
+
+    // Skip empty slots up to the next occupied one or the end of this revolution
+    const uint32_t next_index = index + 1;
+    if (next_index == WHEEL_SLOTS)
+      continue;
+    const uint64_t pending = this->occupied_[0] & (~0ULL << next_index);
+    const uint32_t skip = (pending != 0 ? __builtin_ctzll(pending) : WHEEL_SLOTS) - next_index;
+    const uint32_t remaining = now + 1 - this->wheel_time_;
+    this->wheel_time_ += std::min(skip, remaining);
+  }
+}
+#else
+optional<uint32_t> HOT Scheduler::next_schedule_in() {
+  // Items added since the last call() can be due right away, the loop must not sleep past them
+  if (!this->to_add_.empty())
+    return 0;
   if (this->empty_())
     return {};
   auto &item = this->items_[0];
@@ -91,48 +399,41 @@ void ICACHE_RAM_ATTR HOT Scheduler::call() {
 
   if (now - last_print > 2000) {
     last_print = now;
-    std::vector<std::unique_ptr<SchedulerItem>> old_items;
+    std::vector<SchedulerItem *> old_items;
     ESP_LOGVV(TAG, "Items: count=%u, now=%u", this->items_.size(), now);
     while (!this->empty_()) {
-      auto item = std::move(this->items_[0]);
+      auto *item = this->items_[0];
       const char *type = item->type == SchedulerItem::INTERVAL ? "interval" : "timeout";
-      ESP_LOGVV(TAG, "  %s '%s' interval=%u last_execution=%u (%u) next=%u (%u)", type, item->name.c_str(),
-                item->interval, item->last_execution, item->last_execution_major, item->next_execution(),
+      ESP_LOGVV(TAG, "  %s 0x%08X interval=%u last_execution=%u (%u) next=%u (%u)", type, item->id, item->interval,
+                item->last_execution, item->last_execution_major, item->next_execution(),
                 item->next_execution_major());
 
       this->pop_raw_();
-      old_items.push_back(std::move(item));
+      old_items.push_back(item);
     }
     ESP_LOGVV(TAG, "\n");
     this->items_ = std::move(old_items);
   }
 #endif  // ESPHOME_DEBUG_SCHEDULER
 
-  auto to_remove_was = to_remove_;
-  auto items_was = items_.size();
   // If we have too many items to remove
-  if (to_remove_ > MAX_LOGICALLY_DELETED_ITEMS) {
-    std::vector<std::unique_ptr<SchedulerItem>> valid_items;
-    while (!this->empty_()) {
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
-      valid_items.push_back(std::move(item));
-    }
-    this->items_ = std::move(valid_items);
-
-    // The following should not happen unless I'm missing something
-    if (to_remove_ != 0) {
-      ESP_LOGW(TAG, "to_remove_ was %u now: %u items where %zu now %zu. Please report this", to_remove_was, to_remove_,
-               items_was, items_.size());
-      to_remove_ = 0;
-    }
+  if (this->to_remove_ > MAX_LOGICALLY_DELETED_ITEMS) {
+    // Drop them in place and restore the heap property, without allocating a new vector
+    auto it = std::remove_if(this->items_.begin(), this->items_.end(), [this](SchedulerItem *item) {
+      if (!item->remove)
+        return false;
+      this->free_item_(item);
+      return true;
+    });
+    this->items_.erase(it, this->items_.end());
+    std::make_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+    this->to_remove_ = 0;
   }
 
   while (!this->empty_()) {
     // use scoping to indicate visibility of `item` variable
     {
-      // Don't copy-by value yet
-      auto &item = this->items_[0];
+      auto *item = this->items_[0];
       if ((now - item->last_execution) < item->interval)
         // Not reached timeout yet, done for this call
         break;
@@ -143,24 +444,25 @@ void ICACHE_RAM_ATTR HOT Scheduler::call() {
       // Don't run on failed components
       if (item->component != nullptr && item->component->is_failed()) {
         this->pop_raw_();
+        this->free_item_(item);
         continue;
       }
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
       const char *type = item->type == SchedulerItem::INTERVAL ? "interval" : "timeout";
-      ESP_LOGVV(TAG, "Running %s '%s' with interval=%u last_execution=%u (now=%u)", type, item->name.c_str(),
-                item->interval, item->last_execution, now);
+      ESP_LOGVV(TAG, "Running %s 0x%08X with interval=%u last_execution=%u (now=%u)", type, item->id, item->interval,
+                item->last_execution, now);
 #endif
 
       // Warning: During f(), a lot of stuff can happen, including:
       //  - timeouts/intervals get added, potentially invalidating vector pointers
       //  - timeouts/intervals get cancelled
-      item->f();
+      this->run_item_(item);
     }
 
     {
       // new scope, item from before might have been moved in the vector
-      auto item = std::move(this->items_[0]);
+      auto *item = this->items_[0];
 
       // Only pop after function call, this ensures we were reachable
       // during the function call and know if we were cancelled.
@@ -169,6 +471,7 @@ void ICACHE_RAM_ATTR HOT Scheduler::call() {
       if (item->remove) {
         // We were removed/cancelled in the function call, stop
         to_remove_--;
+        this->free_item_(item);
         continue;
       }
 
@@ -180,7 +483,9 @@ void ICACHE_RAM_ATTR HOT Scheduler::call() {
           if (item->last_execution < before)
             item->last_execution_major++;
         }
-        this->push_(std::move(item));
+        this->push_(item);
+      } else {
+        this->free_item_(item);
       }
     }
   }
@@ -188,47 +493,108 @@ void ICACHE_RAM_ATTR HOT Scheduler::call() {
   this->process_to_add();
 }
 void HOT Scheduler::process_to_add() {
-  for (auto &it : this->to_add_) {
+  for (auto *it : this->to_add_) {
     if (it->remove) {
+      this->free_item_(it);
       continue;
     }
 
-    this->items_.push_back(std::move(it));
+    this->items_.push_back(it);
     std::push_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
   }
   this->to_add_.clear();
 }
 void HOT Scheduler::cleanup_() {
   while (!this->items_.empty()) {
-    auto &item = this->items_[0];
+    auto *item = this->items_[0];
     if (!item->remove)
       return;
 
     to_remove_--;
     this->pop_raw_();
+    this->free_item_(item);
   }
 }
 void HOT Scheduler::pop_raw_() {
   std::pop_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
   this->items_.pop_back();
 }
-void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) { this->to_add_.push_back(std::move(item)); }
-bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
+bool HOT Scheduler::cancel_item_(Component *component, bool has_id, uint32_t id, const std::string *name,
+                                 Scheduler::SchedulerItem::Type type) {
   bool ret = false;
-  for (auto &it : this->items_)
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
+  for (auto *it : this->items_)
+    if (!it->remove && matches_(it, component, has_id, id, name, type)) {
       to_remove_++;
       it->remove = true;
       ret = true;
     }
-  for (auto &it : this->to_add_)
-    if (it->component == component && it->name == name && it->type == type) {
+  for (auto *it : this->to_add_)
+    if (matches_(it, component, has_id, id, name, type)) {
       it->remove = true;
       ret = true;
     }
 
   return ret;
 }
+#endif  // USE_SCHEDULER_TIMER_WHEEL
+void HOT Scheduler::push_(Scheduler::SchedulerItem *item) {
+#ifdef USE_SCHEDULER_TIMER_WHEEL
+  item->slot = WHEEL_NONE;
+  if (item->has_id) {
+    auto *&bucket = this->id_bucket_(item->component, item->id);
+    item->id_next = bucket;
+    bucket = item;
+  }
+#endif
+  this->to_add_.push_back(item);
+}
+bool HOT Scheduler::matches_(const Scheduler::SchedulerItem *item, Component *component, bool has_id, uint32_t id,
+                             const std::string *name, Scheduler::SchedulerItem::Type type) {
+  if (item->component != component || item->type != type || item->has_id != has_id)
+    return false;
+  if (!has_id)
+    return true;
+  // Different names can have the same hash, names are only compared if both sides have one
+  return item->id == id && (name == nullptr || item->name.empty() || item->name == *name);
+}
+Scheduler::SchedulerItem *HOT Scheduler::alloc_item_() {
+  if (this->free_items_.empty()) {
+    ESP_LOGVV(TAG, "Growing item pool by %u", SCHEDULER_POOL_BLOCK_SIZE);
+    this->pool_.emplace_back(new SchedulerItem[SCHEDULER_POOL_BLOCK_SIZE]);
+    this->free_items_.reserve(this->pool_.size() * SCHEDULER_POOL_BLOCK_SIZE);
+    SchedulerItem *block = this->pool_.back().get();
+    for (uint32_t i = 0; i < SCHEDULER_POOL_BLOCK_SIZE; i++)
+      this->free_items_.push_back(&block[i]);
+  }
+  auto *item = this->free_items_.back();
+  this->free_items_.pop_back();
+  return item;
+}
+void HOT Scheduler::run_item_(Scheduler::SchedulerItem *item) {
+#ifdef USE_COMPONENT_PROFILER
+  Component *component = item->component;
+  if (component != nullptr) {
+    const uint32_t start = micros();
+    item->f();
+    component->get_runtime_stats().record(micros() - start);
+    return;
+  }
+#endif
+  item->f();
+}
+void HOT Scheduler::free_item_(Scheduler::SchedulerItem *item) {
+  // destroy the callback now, so that captured resources are released
+  item->f = nullptr;
+#ifdef USE_SCHEDULER_TIMER_WHEEL
+  if (item->has_id) {
+    SchedulerItem **it = &this->id_bucket_(item->component, item->id);
+    while (*it != item)
+      it = &(*it)->id_next;
+    *it = item->id_next;
+  }
+#endif
+  this->free_items_.push_back(item);
+}
 uint32_t Scheduler::millis_() {
   const uint32_t now = millis();
   if (now < this->last_millis_) {
@@ -239,8 +605,7 @@ uint32_t Scheduler::millis_() {
   return now;
 }
 
-bool HOT Scheduler::SchedulerItem::cmp(const std::unique_ptr<SchedulerItem> &a,
-                                       const std::unique_ptr<SchedulerItem> &b) {
+bool HOT Scheduler::SchedulerItem::cmp(SchedulerItem *a, SchedulerItem *b) {
   // min-heap
   // return true if *a* will happen after *b*
   uint32_t a_next_exec = a->next_execution();
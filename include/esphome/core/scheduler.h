@@ -1,6 +1,8 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/helpers.h"
 #include <vector>
 #include <memory>
 
@@ -8,12 +10,39 @@ namespace esphome {
 
 class Component;
 
+/// Callback type of the scheduler, small lambdas (and std::function objects) are stored without heap allocation.
+using SchedulerCallback = InlineFunction<void()>;
+
+/** Timeouts and intervals of all components.
+ *
+ * Items are identified by their component and a 32 bit id. String names are converted to ids with fnv1_hash(),
+ * so `set_timeout(component, "name", ...)` and `set_timeout(component, const_fnv1_hash("name"), ...)` refer
+ * to the same item. The id based methods with a compile-time hash or a plain integer avoid hashing at runtime.
+ * Items set by name keep the name too, so two names with the same hash don't refer to each other's items. An empty
+ * name refers to the items without a name or id, like before ids existed.
+ *
+ * Items are taken from a pool that only grows when more items are pending than ever before, so setting,
+ * cancelling and running timeouts and intervals doesn't allocate in the steady state.
+ *
+ * By default pending items are kept in a binary heap. With USE_SCHEDULER_TIMER_WHEEL (`scheduler: timer_wheel`
+ * in the esphome section) they are kept in a hierarchical timing wheel instead, which has O(1) insertion and
+ * cancellation and never needs to rebuild its storage. It costs about 1.2kB of RAM and pays off with many
+ * (hundreds of) timeouts and intervals.
+ */
 class Scheduler {
  public:
   void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> &&func);
+  void set_timeout(Component *component, uint32_t id, uint32_t timeout, SchedulerCallback &&func);
+  /// Set a timeout that can't be cancelled.
+  void set_timeout(Component *component, uint32_t timeout, SchedulerCallback &&func);
   bool cancel_timeout(Component *component, const std::string &name);
+  bool cancel_timeout(Component *component, uint32_t id);
   void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> &&func);
+  void set_interval(Component *component, uint32_t id, uint32_t interval, SchedulerCallback &&func);
+  /// Set an interval that can't be cancelled.
+  void set_interval(Component *component, uint32_t interval, SchedulerCallback &&func);
   bool cancel_interval(Component *component, const std::string &name);
+  bool cancel_interval(Component *component, uint32_t id);
 
   optional<uint32_t> next_schedule_in();
 
@@ -24,6 +53,9 @@ class Scheduler {
  protected:
   struct SchedulerItem {
     Component *component;
+    uint32_t id;
+    bool has_id;
+    /// The name the item was set with, empty if it was set by id. Kept by the pool, so names reuse their storage.
     std::string name;
     enum Type { TIMEOUT, INTERVAL } type;
     union {
@@ -31,9 +63,19 @@ class Scheduler {
       uint32_t timeout;
     };
     uint32_t last_execution;
-    std::function<void()> f;
+    SchedulerCallback f;
     bool remove;
     uint8_t last_execution_major;
+#ifdef USE_SCHEDULER_TIMER_WHEEL
+    /// Tick this item is due at, only valid while it is in the wheel.
+    uint32_t expires;
+    /// Wheel slot this item is linked into, or WHEEL_NONE.
+    uint16_t slot;
+    SchedulerItem *prev;
+    SchedulerItem *next;
+    /// Next item in the same id bucket.
+    SchedulerItem *id_next;
+#endif
 
     inline uint32_t next_execution() { return this->last_execution + this->timeout; }
     inline uint8_t next_execution_major() {
@@ -44,24 +86,76 @@ class Scheduler {
       return next_exec_major;
     }
 
-    static bool cmp(const std::unique_ptr<SchedulerItem> &a, const std::unique_ptr<SchedulerItem> &b);
+    static bool cmp(SchedulerItem *a, SchedulerItem *b);
   };
 
+  /// `name` is the name the item is set with, nullptr if it's set by id.
+  void set_timeout_(Component *component, bool has_id, uint32_t id, const std::string *name, uint32_t timeout,
+                    SchedulerCallback &&func);
+  void set_interval_(Component *component, bool has_id, uint32_t id, const std::string *name, uint32_t interval,
+                     SchedulerCallback &&func);
   uint32_t millis_();
+  void push_(SchedulerItem *item);
+  /// Cancel the items with the given id and name (nullptr matches any name), or without an id if has_id is false.
+  bool cancel_item_(Component *component, bool has_id, uint32_t id, const std::string *name, SchedulerItem::Type type);
+  static bool matches_(const SchedulerItem *item, Component *component, bool has_id, uint32_t id,
+                       const std::string *name, SchedulerItem::Type type);
+  SchedulerItem *alloc_item_();
+  /// Run the callback of an item, counting its time towards the component with USE_COMPONENT_PROFILER.
+  void run_item_(SchedulerItem *item);
+  void free_item_(SchedulerItem *item);
+
+#ifdef USE_SCHEDULER_TIMER_WHEEL
+  static constexpr uint8_t WHEEL_BITS = 6;
+  static constexpr uint8_t WHEEL_LEVELS = 4;
+  static constexpr uint16_t WHEEL_SLOTS = 1 << WHEEL_BITS;
+  /// Slot of the items that are due after more than 2^(WHEEL_BITS * WHEEL_LEVELS) ms.
+  static constexpr uint16_t WHEEL_FAR = WHEEL_LEVELS * WHEEL_SLOTS;
+  static constexpr uint16_t WHEEL_NONE = 0xFFFF;
+  static constexpr uint8_t ID_BUCKETS = 32;
+
+  /// Link an item into the wheel so that it runs `delta` ticks after wheel_time_.
+  void wheel_insert_(SchedulerItem *item, uint32_t delta);
+  void wheel_unlink_(SchedulerItem *item);
+  /// Take all items out of a slot and insert them again relative to the current wheel_time_.
+  void wheel_cascade_(uint16_t slot);
+  /// Advance the wheel up to and including `now`, moving due items to the expired list.
+  void wheel_advance_(uint32_t now);
+  /// Cancel items without an id, which aren't in the id buckets, so all items are searched.
+  bool cancel_anonymous_(Component *component, SchedulerItem::Type type);
+  SchedulerItem *&id_bucket_(Component *component, uint32_t id) {
+    return this->ids_[(id ^ reinterpret_cast<uintptr_t>(component)) % ID_BUCKETS];
+  }
+
+  /// One list per slot of each level, plus the list of far away items.
+  SchedulerItem *slots_[WHEEL_FAR + 1]{};
+  /// Bitmask of non-empty slots for each level.
+  uint64_t occupied_[WHEEL_LEVELS]{};
+  /// Items with an id, chained through id_next, to make cancelling by id cheap.
+  SchedulerItem *ids_[ID_BUCKETS]{};
+  /// Items that are due and waiting to be run by call(), chained through next.
+  SchedulerItem *expired_head_{nullptr};
+  SchedulerItem *expired_tail_{nullptr};
+  /// The next tick to be processed.
+  uint32_t wheel_time_{0};
+  uint32_t wheel_size_{0};
+#else
   void cleanup_();
   void pop_raw_();
-  void push_(std::unique_ptr<SchedulerItem> item);
-  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
   bool empty_() {
     this->cleanup_();
     return this->items_.empty();
   }
 
-  std::vector<std::unique_ptr<SchedulerItem>> items_;
-  std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  std::vector<SchedulerItem *> items_;
+  uint32_t to_remove_{0};
+#endif
+  std::vector<SchedulerItem *> to_add_;
+  /// Storage of all items, allocated in blocks that are never freed.
+  std::vector<std::unique_ptr<SchedulerItem[]>> pool_;
+  std::vector<SchedulerItem *> free_items_;
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
-  uint32_t to_remove_{0};
 };
 
 }  // namespace esphome